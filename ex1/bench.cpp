@@ -0,0 +1,234 @@
+//shirat345@gmail.com
+// Benchmark runner: times graph construction, updates and every algorithm on the synthetic
+// graph families of Generators, in the spirit of Google Benchmark.
+//
+// Usage: ./bench_runner [filter] [--min-time=seconds] [--trace=file.json]
+//   filter    only run benchmarks whose name contains this text
+//   min-time  minimal measured time per benchmark (default 0.2)
+//   trace     record the algorithm phases of every run as a Chrome trace
+//
+// Every benchmark reports the time per operation, the time per input edge and the number
+// and size of heap allocations per operation (counted by the operator new below, or by
+// AllocationTracker in a TRACK_ALLOC=1 build, which also prints a per-component report).
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include <string>
+#include <vector>
+#include <functional>
+#include "Graph.h"
+#include "Algorithms.h"
+#include "Generators.h"
+#include "Tracer.h"
+#include "AllocationTracker.h"
+using namespace graph;
+
+#ifndef EX1_TRACK_ALLOC
+static std::atomic<long long> allocCount(0);
+static std::atomic<long long> allocBytes(0);
+
+void* operator new(std::size_t size) {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+static long long allocationsSoFar() {
+    return allocCount.load();
+}
+
+static long long bytesSoFar() {
+    return allocBytes.load();
+}
+#else
+// The allocation-tracking build replaces operator new itself; use its totals
+static long long allocationsSoFar() {
+    return AllocationTracker::total().allocations;
+}
+
+static long long bytesSoFar() {
+    return AllocationTracker::total().bytes;
+}
+#endif
+
+// Keeps results observable so the optimizer cannot drop the measured work
+static volatile long long sink = 0;
+
+/*
+ * Input graph of a benchmark: an edge list that can be turned into a Graph.
+ */
+struct Family {
+    std::string name;
+    int vertices;
+    std::vector<int> src, dest, weight;
+
+    Graph build() const {
+        Graph g(vertices);
+        for (size_t i = 0; i < src.size(); i++) {
+            g.addEdge(src[i], dest[i], weight[i]);
+        }
+        return g;
+    }
+};
+
+// Collects the edges of a generated graph (each undirected edge once)
+static Family fromGraph(const std::string& name, const Graph& g) {
+    Family f;
+    f.name = name + "/" + std::to_string(g.getNumVertices());
+    f.vertices = g.getNumVertices();
+    for (int u = 0; u < f.vertices; u++) {
+        for (NeighborVer* n = g.getAdjList()[u].neighbors; n; n = n->next) {
+            if (u < n->vertex) {
+                f.src.push_back(u);
+                f.dest.push_back(n->vertex);
+                f.weight.push_back(n->weight);
+            }
+        }
+    }
+    return f;
+}
+
+// Returns a vertex not adjacent to 0, used for the addEdge/removeEdge pair
+static int farVertex(const Graph& g) {
+    for (int v = g.getNumVertices() - 1; v > 0; v--) {
+        bool adjacent = false;
+        for (NeighborVer* n = g.getAdjList()[0].neighbors; n; n = n->next) {
+            if (n->vertex == v) adjacent = true;
+        }
+        if (!adjacent) return v;
+    }
+    return -1;
+}
+
+/*
+ * Runs 'op' until at least minTime seconds were measured and prints one result line.
+ */
+static void run(const std::string& name, long long edges, double minTime, const std::function<void()>& op) {
+    op();  // Warm-up
+
+    long long iterations = 0;
+    long long allocs0 = allocationsSoFar();
+    long long bytes0 = bytesSoFar();
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    long long batch = 1;
+    while (elapsed < minTime) {
+        for (long long i = 0; i < batch; i++) {
+            op();
+        }
+        iterations += batch;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        batch *= 2;
+    }
+    double allocs = static_cast<double>(allocationsSoFar() - allocs0) / iterations;
+    double bytes = static_cast<double>(bytesSoFar() - bytes0) / iterations;
+    double ns = elapsed * 1e9 / iterations;
+
+    std::cout << std::left << std::setw(32) << name << std::right
+              << std::fixed << std::setprecision(0) << std::setw(14) << ns
+              << std::setw(12) << iterations
+              << std::setprecision(2) << std::setw(10) << (edges ? ns / edges : 0.0)
+              << std::setprecision(1) << std::setw(12) << allocs
+              << std::setprecision(0) << std::setw(14) << bytes << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string tracePath;
+    double minTime = 0.2;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+            minTime = std::atof(argv[i] + 11);
+        } else if (std::strncmp(argv[i], "--trace=", 8) == 0) {
+            tracePath = argv[i] + 8;
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    std::vector<Family> families;
+    families.push_back(fromGraph("erdos-renyi", Generators::erdosRenyi(1000, 4000, 1)));
+    families.push_back(fromGraph("erdos-renyi", Generators::erdosRenyi(4000, 16000, 2)));
+    families.push_back(fromGraph("rmat", Generators::rmat(12, 16000, 3)));
+    families.push_back(fromGraph("barabasi-albert", Generators::barabasiAlbert(4000, 4, 4)));
+    families.push_back(fromGraph("grid", Generators::grid(64, 64, 5)));
+    families.push_back(fromGraph("path", Generators::path(10000, 6)));
+
+    ChromeTraceExporter exporter;
+    if (!tracePath.empty()) {
+        Tracer::setTracer(&exporter);
+    }
+
+    std::cout << std::left << std::setw(32) << "Benchmark" << std::right
+              << std::setw(14) << "Time(ns)" << std::setw(12) << "Iterations"
+              << std::setw(10) << "ns/edge" << std::setw(12) << "allocs/op"
+              << std::setw(14) << "bytes/op" << std::endl;
+    std::cout << std::string(94, '-') << std::endl;
+
+    for (const Family& f : families) {
+        Graph g = f.build();
+        long long edges = static_cast<long long>(f.src.size());
+        std::vector<std::pair<std::string, std::function<void()>>> benchmarks;
+
+        benchmarks.push_back({"construct", [&f]() {
+            Graph built = f.build();
+            sink += built.getNumVertices();
+        }});
+        int far = farVertex(g);
+        benchmarks.push_back({"addEdge+removeEdge", [&g, far]() {
+            // Vertex 0 is the largest hub of the R-MAT and Barabási–Albert graphs
+            g.addEdge(0, far, 7);
+            g.removeEdge(0, far);
+        }});
+        benchmarks.push_back({"bfs", [&g]() { sink += Algorithms::bfs(0, g).getNumVertices(); }});
+        benchmarks.push_back({"dfs", [&g]() { sink += Algorithms::dfs(0, g).getNumVertices(); }});
+        benchmarks.push_back({"dijkstra", [&g]() { sink += Algorithms::dijkstra(0, g).getNumVertices(); }});
+        benchmarks.push_back({"prim", [&g]() { sink += Algorithms::prim(g).getNumVertices(); }});
+        benchmarks.push_back({"kruskal", [&g]() { sink += Algorithms::kruskal(g).getNumVertices(); }});
+
+        for (size_t i = 0; i < benchmarks.size(); i++) {
+            std::string name = benchmarks[i].first + "/" + f.name;
+            if (!filter.empty() && name.find(filter) == std::string::npos) continue;
+            // addEdge+removeEdge is timed per operation pair, everything else per input edge
+            long long perEdge = (benchmarks[i].first == "addEdge+removeEdge") ? 0 : edges;
+            run(name, perEdge, minTime, benchmarks[i].second);
+        }
+    }
+
+    if (!tracePath.empty()) {
+        Tracer::setTracer(nullptr);
+        exporter.save(tracePath);
+        std::cout << "Trace with " << exporter.getNumEvents() << " phases written to " << tracePath << std::endl;
+    }
+    if (AllocationTracker::enabled()) {
+        std::cout << std::endl;
+        AllocationTracker::report(std::cout);
+    }
+    return 0;
+}
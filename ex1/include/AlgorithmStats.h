@@ -0,0 +1,63 @@
+// shirat345@gmail.com
+#pragma once
+
+namespace graph {
+
+    /*
+     * Counters describing the work done by one call of bfs, dfs, dijkstra, prim or kruskal
+     * on a Graph. They are only collected in builds compiled with EX1_STATS (make STATS=1);
+     * otherwise the counting macros below expand to nothing and every counter stays 0.
+     *
+     * - verticesSettled: vertices dequeued (bfs), discovered (dfs) or settled (dijkstra, prim).
+     * - edgesScanned: adjacency entries examined.
+     * - edgesRelaxed: entries that discovered a vertex or improved its distance / key;
+     *   for kruskal, edges accepted into the tree.
+     * - heapPushes / heapPops: priority queue operations.
+     * - staleEntries: popped entries skipped because their vertex was already settled.
+     * - findCalls / findSteps: UnionFind::find calls and parent links followed by them
+     *   (findSteps / findCalls is the average find depth).
+     */
+    struct AlgorithmStats {
+        long long verticesSettled;
+        long long edgesScanned;
+        long long edgesRelaxed;
+        long long heapPushes;
+        long long heapPops;
+        long long staleEntries;
+        long long findCalls;
+        long long findSteps;
+
+        AlgorithmStats() {
+            reset();
+        }
+
+        void reset() {
+            verticesSettled = edgesScanned = edgesRelaxed = 0;
+            heapPushes = heapPops = staleEntries = 0;
+            findCalls = findSteps = 0;
+        }
+
+        /*
+         * Counters of the call in progress and of the last finished call, per thread.
+         */
+        static AlgorithmStats& current() {
+            static thread_local AlgorithmStats stats;
+            return stats;
+        }
+
+        static AlgorithmStats& last() {
+            static thread_local AlgorithmStats stats;
+            return stats;
+        }
+    };
+}
+
+#ifdef EX1_STATS
+#define EX1_STATS_BEGIN() (::graph::AlgorithmStats::current().reset())
+#define EX1_STATS_ADD(field, n) (::graph::AlgorithmStats::current().field += (n))
+#define EX1_STATS_END() (::graph::AlgorithmStats::last() = ::graph::AlgorithmStats::current())
+#else
+#define EX1_STATS_BEGIN() ((void)0)
+#define EX1_STATS_ADD(field, n) ((void)0)
+#define EX1_STATS_END() ((void)0)
+#endif
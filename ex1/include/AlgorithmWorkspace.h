@@ -0,0 +1,84 @@
+// shirat345@gmail.com
+#pragma once
+#include "Graph.h"
+#include "IndexedHeap.h"
+#include "PriorityQueue.h"
+
+namespace graph {
+
+    /*
+     * AlgorithmWorkspace holds the per-vertex scratch arrays used by bfs, dfs, dijkstra and prim,
+     * so a caller running many queries can allocate them once and reuse them.
+     *
+     * Instead of clearing the arrays before every query, each query gets a new generation number;
+     * a vertex counts as reached / settled only if its stamp equals the current generation.
+     * Starting a query is therefore O(1) (the arrays only grow when a larger graph comes along).
+     *
+     * After a query the results stay available through getDistance / getParent:
+     * - bfs: number of edges from the start vertex.
+     * - dfs: depth in the DFS forest.
+     * - dijkstra: shortest distance from the start vertex.
+     * - prim: weight of the tree edge connecting the vertex to its parent.
+     *
+     * A workspace must not be used by two queries at the same time.
+     */
+    class AlgorithmWorkspace {
+        friend class Algorithms;
+
+        int capacity;               // Number of vertices the arrays can hold
+        int numVertices;            // Vertex count of the current query
+        unsigned int generation;    // Stamp of the current query
+        unsigned int* reached;      // reached[v] == generation: dist[v] and parent[v] are valid
+        unsigned int* settled;      // settled[v] == generation: v is finished
+        int* dist;
+        int* parent;
+        int* order;                 // BFS queue / DFS stack
+        int* visit;                 // DFS / prim: vertices in the order they joined the tree
+        int* weight;                // BFS / DFS: weight of the tree edge to the parent; prim array scan: keys
+        NeighborVer** cursor;       // DFS: next neighbor to examine for each vertex
+        PriorityQueue heap;         // Reused by dijkstra
+        IndexedHeap vertexHeap;     // Reused by prim (one entry per vertex, decrease-key)
+
+        /*
+         * Prepares the workspace for a query on 'vertices' vertices: grows the arrays if needed
+         * and starts a new generation.
+         */
+        void begin(int vertices);
+
+    public:
+        /*
+         * Constructor: optionally pre-allocates room for 'vertices' vertices.
+         */
+        explicit AlgorithmWorkspace(int vertices = 0);
+
+        /*
+         * Destructor: frees the scratch arrays.
+         */
+        ~AlgorithmWorkspace();
+
+        AlgorithmWorkspace(const AlgorithmWorkspace&) = delete;
+        AlgorithmWorkspace& operator=(const AlgorithmWorkspace&) = delete;
+
+        /*
+         * Grows the arrays to hold at least 'vertices' vertices.
+         */
+        void reserve(int vertices);
+
+        /*
+         * Returns the number of vertices the workspace can currently hold.
+         */
+        int getCapacity() const;
+
+        /*
+         * Returns the result of the last query for 'v' (see above), or -1 / INT_MAX
+         * if 'v' was not reached.
+         */
+        int getDistance(int v) const;
+        int getParent(int v) const;
+
+        /*
+         * Returns true if 'v' was reached by the last query.
+         */
+        bool wasReached(int v) const;
+    };
+}
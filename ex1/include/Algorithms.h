@@ -1,13 +1,60 @@
 // shirat345@gmail.com
 #pragma once
 #include "Graph.h"
+#include "CSRGraph.h"
+#include "DeltaGraph.h"
+#include "AlgorithmWorkspace.h"
+#include "AlgorithmStats.h"
+#include "DistanceMatrix.h"
 
 namespace graph {
 
     // The Algorithms class contains static methods that implement various graph algorithms.
     // Each algorithm operates on a graph and performs specific tasks such as searching, finding shortest paths, or finding spanning trees.
+    // Traversals and shortest paths follow edge directions in directed graphs and return directed trees;
+    // spanning tree algorithms require an undirected graph.
     class Algorithms {
+        // Dijkstra distances from 'startVertex' into 'dist' using the scratch of 'ws' (no checks)
+        static void dijkstraRow(int startVertex, const CSRGraph& g, int* dist, AlgorithmWorkspace& ws);
+
+    public:
+        // Strategies of allPairsShortestPaths
+        enum AllPairsMethod { AUTO, FLOYD_WARSHALL, REPEATED_DIJKSTRA, JOHNSON };
+
+        // Variants of bellmanFord:
+        // - ROUNDS: classic Bellman-Ford, relaxing every edge per round, stopping after a quiet round.
+        // - SPFA: queue-based, only re-examines vertices whose distance dropped.
+        // - PARALLEL_ROUNDS: rounds over the vertices that changed in the previous round,
+        //   relaxed concurrently on ThreadPool::shared() (atomic distance updates).
+        enum BellmanFordVariant { ROUNDS, SPFA, PARALLEL_ROUNDS };
+
+        // Variants of prim:
+        // - PRIM_AUTO: on a CSRGraph, picks one of the others from its density (see choosePrimVariant);
+        //   on a Graph, INDEXED_HEAP (walking the adjacency lists dominates, so the scan gains nothing).
+        // - INDEXED_HEAP: heap with decrease-key, O(E log V); best for sparse graphs.
+        // - ARRAY_SCAN: finds the next vertex with a vectorized scan of the key array, O(V^2 + E);
+        //   best for dense graphs, where E is close to V^2.
+        enum PrimVariant { PRIM_AUTO, INDEXED_HEAP, ARRAY_SCAN };
+
+    private:
+        // Bellman-Ford from 'startVertex' (or from all vertices at distance 0 if it is -1) into
+        // dist / parent (-1 for sources and unreachable vertices). Returns false if it reaches
+        // a negative cycle, leaving dist / parent undefined.
+        static bool bellmanFordCore(int startVertex, const CSRGraph& g, int* dist, int* parent, BellmanFordVariant variant);
+
+        // Search phase of prim for both variants: grows the spanning forest from 'startVertex'
+        // in 'ws' (see prim) and returns the number of vertices settled (all of them).
+        // Both run on any graph type that provides forEachNeighbor(v, f).
+        template <typename G>
+        static int primIndexedHeap(const G& g, AlgorithmWorkspace& ws, int startVertex);
+        template <typename G>
+        static int primArrayScan(const G& g, AlgorithmWorkspace& ws, int startVertex);
+
+        // Build phase of prim: the forest whose edges the search left in 'ws'.
+        static Graph primForest(const AlgorithmWorkspace& ws, int settledCount);
+
     public:
+
         // bfs: Performs a Breadth-First Search (BFS) on the given graph 'g' starting from 'startVertex'.
         // It returns a new graph representing the BFS tree.
         static Graph bfs(int startVertex, const Graph& g);
@@ -24,12 +71,82 @@ namespace graph {
         // It returns a graph representing the shortest path tree.
         static Graph dijkstra(int startVertex, const Graph& g);
 
-        // prim: Implements Prim's algorithm to find the Minimum Spanning Tree (MST) of the given graph 'g'.
-        // It returns a graph representing the MST.
-        static Graph prim(const Graph& g);
+        // prim: Implements Prim's algorithm to find the Minimum Spanning Tree (MST) of the given graph 'g',
+        // growing it from 'startVertex'. If 'g' is disconnected the search restarts from every vertex
+        // not reached yet, so it returns a minimum spanning forest (one tree per component).
+        // 'variant' selects how the next vertex is found (see PrimVariant); all return a minimum forest.
+        static Graph prim(const Graph& g, int startVertex = 0, PrimVariant variant = PRIM_AUTO);
 
         // kruskal: Implements Kruskal's algorithm to find the Minimum Spanning Tree (MST) of the given graph 'g'.
         // It returns a graph representing the MST.
         static Graph kruskal(const Graph& g);
+
+        // Overloads operating directly on a compact CSRGraph (e.g. a memory-mapped graph file).
+        // They return the same trees as the Graph versions, without converting the input.
+        // They only read 'g' and keep their scratch memory per call, so any number of threads
+        // may run them on the same CSRGraph (e.g. GraphSnapshot::getGraph()) at once.
+        static Graph bfs(int startVertex, const CSRGraph& g);
+        static Graph dfs(int startVertex, const CSRGraph& g);
+        static Graph dijkstra(int startVertex, const CSRGraph& g);
+        static Graph prim(const CSRGraph& g, int startVertex = 0, PrimVariant variant = PRIM_AUTO);
+
+        // bfsDistances: Fills dist[v] with the number of edges on a shortest path from 'startVertex'
+        // to v (INT_MAX if unreachable). Level-synchronous BFS over bitmap frontiers, whose
+        // updates use the vectorized kernels of Simd. 'dist' must hold g.getNumVertices() entries.
+        static void bfsDistances(int startVertex, const CSRGraph& g, int* dist);
+
+        // dijkstraDistances: Fills dist[v] with the shortest distance from 'startVertex' to v
+        // (INT_MAX if unreachable), without building a tree. 'dist' must hold g.getNumVertices() entries.
+        static void dijkstraDistances(int startVertex, const CSRGraph& g, int* dist);
+
+        // bellmanFord: Shortest path tree from 'startVertex' like dijkstra, for graphs that may
+        // contain negative weights. O(V E) in the worst case for every variant.
+        // Throws invalid_argument if a negative cycle is reachable from 'startVertex'
+        // (in an undirected graph every negative edge is such a cycle).
+        static Graph bellmanFord(int startVertex, const Graph& g, BellmanFordVariant variant = SPFA);
+
+        // bellmanFordDistances: Fills dist[v] with the shortest distance from 'startVertex' to v
+        // (INT_MAX if unreachable); same rules as bellmanFord. 'dist' must hold g.getNumVertices() entries.
+        static void bellmanFordDistances(int startVertex, const CSRGraph& g, int* dist, BellmanFordVariant variant = SPFA);
+
+        // hasNegativeCycle: Returns true if 'g' contains a negative cycle anywhere,
+        // reachable from some vertex or not.
+        static bool hasNegativeCycle(const Graph& g);
+        static bool hasNegativeCycle(const CSRGraph& g);
+
+        // allPairsShortestPaths: Computes the distance between every pair of vertices.
+        // FLOYD_WARSHALL runs a cache-blocked Floyd-Warshall in O(V^3) (negative edge weights are
+        // allowed, negative cycles are not); REPEATED_DIJKSTRA runs dijkstraDistances from every
+        // vertex in O(V E log V) (non-negative weights only); JOHNSON reweights the edges once
+        // with Bellman-Ford so that repeated Dijkstra also handles negative weights.
+        // All of them run on ThreadPool::shared().
+        // AUTO picks the cheapest one for the density and weights of the graph (see chooseAllPairsMethod).
+        static DistanceMatrix allPairsShortestPaths(const Graph& g, AllPairsMethod method = AUTO);
+        static DistanceMatrix allPairsShortestPaths(const CSRGraph& g, AllPairsMethod method = AUTO);
+
+        // chooseAllPairsMethod: The method AUTO uses for 'g'.
+        static AllPairsMethod chooseAllPairsMethod(const CSRGraph& g);
+
+        // Overloads operating on a DeltaGraph, merging its base and pending updates on the fly.
+        static Graph bfs(int startVertex, const DeltaGraph& g);
+        static Graph dijkstra(int startVertex, const DeltaGraph& g);
+
+        // Overloads reusing the scratch arrays of 'ws' instead of allocating them on every call.
+        // They return the same trees as the versions above and leave per-vertex results in 'ws'.
+        static Graph bfs(int startVertex, const Graph& g, AlgorithmWorkspace& ws);
+        static Graph dfs(int startVertex, const Graph& g, AlgorithmWorkspace& ws);
+        static Graph dijkstra(int startVertex, const Graph& g, AlgorithmWorkspace& ws);
+        static Graph prim(const Graph& g, AlgorithmWorkspace& ws, int startVertex = 0, PrimVariant variant = PRIM_AUTO);
+
+        // choosePrimVariant: The variant PRIM_AUTO uses for the CSRGraph 'g', decided in O(1)
+        // from its vertex and entry counts.
+        static PrimVariant choosePrimVariant(const CSRGraph& g);
+
+        // lastStats: Returns the counters of the most recent bfs, dfs, dijkstra, prim or kruskal call
+        // on a Graph in the calling thread. All zero unless built with EX1_STATS (see AlgorithmStats.h).
+        static const AlgorithmStats& lastStats();
+
+        // statsEnabled: Returns true if this build collects the counters.
+        static bool statsEnabled();
     };
 }
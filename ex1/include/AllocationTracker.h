@@ -0,0 +1,118 @@
+// shirat345@gmail.com
+#pragma once
+#include <cstddef>
+#include <ostream>
+
+namespace graph {
+
+    /*
+     * AllocationTracker counts heap allocations per component in builds compiled with
+     * EX1_TRACK_ALLOC (make TRACK_ALLOC=1). In that build the global operator new / delete are
+     * replaced: every block carries a small header with its size and the component that was
+     * active (see EX1_ALLOC_SCOPE) when it was allocated, so frees are charged to the right
+     * component. Without EX1_TRACK_ALLOC nothing is replaced and all counters stay 0.
+     *
+     * The Graph versions of bfs, dfs, dijkstra, prim and kruskal also record, per call, the number
+     * of allocations and the peak number of bytes the calling thread held at once (lastCall).
+     */
+    class AllocationTracker {
+    public:
+        enum Component {
+            GRAPH,              // Graph adjacency lists and nodes
+            QUEUE,              // Queue nodes
+            PRIORITY_QUEUE,     // PriorityQueue arrays
+            UNION_FIND,         // UnionFind arrays
+            WORKSPACE,          // AlgorithmWorkspace arrays
+            CSR,                // CSRGraph and GraphBuilder arrays
+            ALGORITHM,          // Other scratch memory inside Algorithms
+            OTHER,              // Everything allocated outside a scope
+            NUM_COMPONENTS
+        };
+
+        struct Counters {
+            long long allocations;   // Number of allocations
+            long long frees;         // Number of frees
+            long long bytes;         // Total bytes allocated
+            long long liveBytes;     // Bytes currently allocated
+            long long peakBytes;     // Highest value of liveBytes
+        };
+
+        struct CallStats {
+            const char* algorithm;   // Name of the last finished call, or nullptr
+            long long allocations;   // Allocations made by the calling thread during the call
+            long long bytes;         // Bytes allocated during the call
+            long long peakBytes;     // Highest amount of memory held at once during the call
+        };
+
+        /*
+         * Returns true if this build tracks allocations.
+         */
+        static bool enabled();
+
+        /*
+         * Counters of one component (all threads), and their sum over all components.
+         * peakBytes of the total is the highest overall live size.
+         */
+        static Counters get(Component component);
+        static Counters total();
+
+        /*
+         * Statistics of the last tracked algorithm call in the calling thread.
+         */
+        static CallStats lastCall();
+
+        /*
+         * Resets the counters of every component (live bytes are kept, peaks restart from them).
+         */
+        static void reset();
+
+        static const char* name(Component component);
+
+        /*
+         * Prints one line per component.
+         */
+        static void report(std::ostream& out);
+
+        // Hooks used by the replaced operator new / delete
+        static void* allocate(std::size_t size);
+        static void release(void* p);
+    };
+
+    /*
+     * Charges allocations made by this thread to 'component' until the scope ends.
+     */
+    class AllocationScope {
+        int previous;
+
+    public:
+        explicit AllocationScope(AllocationTracker::Component component);
+        ~AllocationScope();
+
+        AllocationScope(const AllocationScope&) = delete;
+        AllocationScope& operator=(const AllocationScope&) = delete;
+    };
+
+    /*
+     * Marks one algorithm call: measures allocations and the peak held memory of this thread
+     * until the outermost AllocationCall ends (nested calls belong to the outer one).
+     * Allocations inside it are charged to ALGORITHM unless an inner scope says otherwise.
+     */
+    class AllocationCall {
+        AllocationScope scope;
+
+    public:
+        explicit AllocationCall(const char* algorithm);
+        ~AllocationCall();
+
+        AllocationCall(const AllocationCall&) = delete;
+        AllocationCall& operator=(const AllocationCall&) = delete;
+    };
+}
+
+#ifdef EX1_TRACK_ALLOC
+#define EX1_ALLOC_SCOPE(component) ::graph::AllocationScope ex1AllocScope(::graph::AllocationTracker::component)
+#define EX1_ALLOC_CALL(algorithm) ::graph::AllocationCall ex1AllocCall(algorithm)
+#else
+#define EX1_ALLOC_SCOPE(component) ((void)0)
+#define EX1_ALLOC_CALL(algorithm) ((void)0)
+#endif
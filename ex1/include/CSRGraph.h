@@ -0,0 +1,106 @@
+// shirat345@gmail.com
+#pragma once
+#include "Graph.h"
+
+namespace graph {
+
+    /*
+     * CSRGraph is an immutable, compact (Compressed Sparse Row) form of a graph.
+     * The neighbors of vertex v are stored contiguously in
+     *   targets[offsets[v] .. offsets[v + 1]) with matching weights.
+     * Each undirected edge is stored twice (once per direction), exactly as in Graph;
+     * a directed graph stores only the out-edges of each vertex.
+     *
+     * A CSRGraph either owns its arrays (when built from a Graph) or is a
+     * read-only view over memory owned by someone else (e.g. a memory-mapped file).
+     */
+    class CSRGraph {
+        friend class GraphBuilder;
+
+        int numVertices;       // Total number of vertices
+        int numEntries;        // Total number of adjacency entries (sum of all degrees)
+        const int* offsets;    // numVertices + 1 row offsets into targets/weights
+        const int* targets;    // Neighbor vertex of each adjacency entry
+        const int* weights;    // Weight of each adjacency entry
+        int* storage;          // Owned block holding all three arrays, or nullptr for a view
+        bool directed;         // True if each edge is stored only in its source row
+
+        /*
+         * Takes ownership of a block laid out as [offsets | targets | weights].
+         */
+        CSRGraph(int vertices, int entries, int* storage, bool directed);
+
+    public:
+        /*
+         * Builds a compact copy of 'g'. Neighbor order matches the order of g's adjacency lists.
+         */
+        explicit CSRGraph(const Graph& g);
+
+        /*
+         * Wraps existing arrays without copying them. The caller keeps ownership
+         * and must keep the memory alive for the lifetime of this object.
+         */
+        CSRGraph(int vertices, int entries, const int* offsets, const int* targets, const int* weights, bool directed = false);
+
+        /*
+         * Destructor: frees the arrays if they are owned.
+         */
+        ~CSRGraph();
+
+        CSRGraph(const CSRGraph&) = delete;
+        CSRGraph& operator=(const CSRGraph&) = delete;
+
+        /*
+         * Move constructor: takes over the arrays of 'other', leaving it empty.
+         */
+        CSRGraph(CSRGraph&& other);
+
+        /*
+         * Returns the number of vertices in the graph.
+         */
+        int getNumVertices() const;
+
+        /*
+         * Returns the number of adjacency entries (each undirected edge counts twice,
+         * each directed edge once).
+         */
+        int getNumEntries() const;
+
+        /*
+         * Returns true if the graph is directed.
+         */
+        bool isDirected() const;
+
+        /*
+         * Return the raw CSR arrays. Algorithms read these directly for zero-copy traversal.
+         */
+        const int* getOffsets() const;
+        const int* getTargets() const;
+        const int* getWeights() const;
+
+        /*
+         * Returns the number of neighbors of vertex 'v'.
+         */
+        int degree(int v) const;
+
+        /*
+         * Calls f(neighbor, weight) for every neighbor of 'v', in row order.
+         */
+        template <typename F>
+        void forEachNeighbor(int v, F f) const {
+            for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+                f(targets[i], weights[i]);
+            }
+        }
+
+        /*
+         * Checks if any edge in the graph has a negative weight.
+         */
+        bool hasNegativeWeights() const;
+
+        /*
+         * Builds a regular (mutable) Graph with the same adjacency lists, in the same order.
+         */
+        Graph toGraph() const;
+    };
+}
@@ -0,0 +1,190 @@
+// shirat345@gmail.com
+#pragma once
+#include "Graph.h"
+#include "CSRGraph.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace graph {
+
+    /*
+     * DeltaOverlay describes a graph as an immutable CSRGraph base plus a small set of changes:
+     * - added:   edges inserted after the base was built, or base edges whose weight changed.
+     * - removed: tombstones for base edges that were deleted.
+     * Both are kept as directed Graphs so each vertex has its own short change list.
+     */
+    class DeltaOverlay {
+        const CSRGraph* base;   // Not owned
+        Graph added;            // Per-vertex inserted / re-weighted edges
+        Graph removed;          // Per-vertex deleted base edges (weights unused)
+        int changes;            // Number of entries in 'added' and 'removed'
+
+        void addDirected(int src, int dest, int weight);
+        bool removeDirected(int src, int dest);
+        bool baseWeight(int src, int dest, int& weight) const;
+        static bool contains(const NeighborVer* list, int vertex);
+
+    public:
+        /*
+         * Constructor: an overlay with no changes on top of 'base'.
+         */
+        explicit DeltaOverlay(const CSRGraph* base);
+
+        DeltaOverlay(const DeltaOverlay&) = delete;
+        DeltaOverlay& operator=(const DeltaOverlay&) = delete;
+
+        /*
+         * Same semantics as Graph::addEdge / Graph::removeEdge.
+         */
+        void addEdge(int src, int dest, int weight);
+        void removeEdge(int src, int dest);
+
+        /*
+         * Returns true if the merged graph has the edge src -> dest.
+         */
+        bool hasEdge(int src, int dest) const;
+
+        /*
+         * Returns the number of change entries on top of the base.
+         */
+        int getNumChanges() const;
+
+        const CSRGraph& getBase() const;
+
+        /*
+         * Calls f(neighbor, weight) for every neighbor of 'v' in the merged graph:
+         * base entries that are neither deleted nor re-weighted, then the added entries.
+         */
+        template <typename F>
+        void forEachNeighbor(int v, F f) const {
+            const int* offsets = base->getOffsets();
+            const int* targets = base->getTargets();
+            const int* weights = base->getWeights();
+            NeighborVer* addedRow = added.getAdjList()[v].neighbors;
+            NeighborVer* removedRow = removed.getAdjList()[v].neighbors;
+            for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+                if ((addedRow || removedRow) && (contains(addedRow, targets[i]) || contains(removedRow, targets[i]))) {
+                    continue;
+                }
+                f(targets[i], weights[i]);
+            }
+            for (NeighborVer* n = addedRow; n; n = n->next) {
+                f(n->vertex, n->weight);
+            }
+        }
+
+        /*
+         * Builds a new compact base containing the merged graph.
+         */
+        CSRGraph build() const;
+    };
+
+    /*
+     * DeltaGraph is a mutable graph made of a frozen CSRGraph base and a DeltaOverlay.
+     * Updates only touch the overlay; reads merge base and overlay on the fly.
+     * compact() folds the overlay into a new base. It can also run on a background thread:
+     * the new base is built from a snapshot without blocking writers, and the updates
+     * that arrived meanwhile are replayed on top of it (they are kept in an operation log).
+     *
+     * All public methods are thread-safe. Traversals hold the graph's lock for their duration
+     * (see lockForRead), so they see a consistent graph even while compaction finishes.
+     */
+    class DeltaGraph {
+        struct Operation {
+            int src;
+            int dest;
+            int weight;
+            bool remove;
+        };
+
+        int const numVertices;
+        bool const directed;
+        CSRGraph* base;             // Owned current base
+        DeltaOverlay* overlay;      // Owned overlay on top of 'base'
+        Operation* log;             // Updates applied since 'base' was built
+        int logSize;
+        int logCapacity;
+        mutable std::mutex lock;    // Guards base, overlay and log
+        std::mutex compactionLock;  // Allows only one compaction at a time
+
+        std::thread compactor;      // Background compaction thread (if started)
+        std::condition_variable wakeup;
+        bool stopping;
+
+        void appendLog(int src, int dest, int weight, bool remove);
+        void compactLoop(int threshold, int intervalMillis);
+
+    public:
+        /*
+         * Constructor: takes a compact copy of 'g' as the initial base.
+         */
+        explicit DeltaGraph(const Graph& g);
+
+        /*
+         * Constructor: takes over 'base' (moved in).
+         */
+        explicit DeltaGraph(CSRGraph&& base);
+
+        /*
+         * Destructor: stops background compaction and frees the base and overlay.
+         */
+        ~DeltaGraph();
+
+        DeltaGraph(const DeltaGraph&) = delete;
+        DeltaGraph& operator=(const DeltaGraph&) = delete;
+
+        int getNumVertices() const;
+        bool isDirected() const;
+
+        /*
+         * Same semantics and exceptions as Graph::addEdge / Graph::removeEdge.
+         */
+        void addEdge(int src, int dest, int weight = 1);
+        void removeEdge(int src, int dest);
+
+        /*
+         * Returns true if the edge src -> dest exists.
+         */
+        bool hasEdge(int src, int dest) const;
+
+        /*
+         * Returns the number of change entries not yet folded into the base.
+         */
+        int getDeltaSize() const;
+
+        /*
+         * Folds all pending changes into a new base.
+         */
+        void compact();
+
+        /*
+         * Starts a thread that calls compact() every 'intervalMillis' milliseconds
+         * whenever the delta has at least 'threshold' entries. Throws logic_error if already running.
+         */
+        void startBackgroundCompaction(int threshold, int intervalMillis);
+
+        /*
+         * Stops the background thread (no-op if it is not running).
+         */
+        void stopBackgroundCompaction();
+
+        /*
+         * Locks the graph against updates and compaction; traversals hold this while reading.
+         */
+        std::unique_lock<std::mutex> lockForRead() const;
+
+        /*
+         * Calls f(neighbor, weight) for every neighbor of 'v'. The caller must hold lockForRead().
+         */
+        template <typename F>
+        void forEachNeighbor(int v, F f) const {
+            overlay->forEachNeighbor(v, f);
+        }
+
+        /*
+         * Returns a compact copy of the current graph (base and delta merged).
+         */
+        CSRGraph snapshot() const;
+    };
+}
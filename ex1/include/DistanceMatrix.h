@@ -0,0 +1,57 @@
+// shirat345@gmail.com
+#pragma once
+#include <cstddef>
+
+namespace graph {
+
+    /*
+     * DistanceMatrix holds the result of an all-pairs shortest path computation:
+     * the distance from every vertex u to every vertex v, INT_MAX if v is unreachable from u
+ * (or if the distance does not fit in an int).
+     *
+     * The V x V distances are stored row by row in one contiguous int array
+     * (4 * V^2 bytes, e.g. 400 MB for 10000 vertices), so the row of a source is contiguous.
+     */
+    class DistanceMatrix {
+        friend class Algorithms;
+
+        int numVertices;    // Number of rows and columns
+        int* data;          // Row-major distances
+
+        /*
+         * Returns the writable row of 'u' (no range check).
+         */
+        int* row(int u);
+
+    public:
+        /*
+         * Constructor: a matrix for 'vertices' vertices with every distance set to INT_MAX.
+         */
+        explicit DistanceMatrix(int vertices);
+
+        /*
+         * Destructor: frees the distances.
+         */
+        ~DistanceMatrix();
+
+        DistanceMatrix(const DistanceMatrix&) = delete;
+        DistanceMatrix& operator=(const DistanceMatrix&) = delete;
+
+        /*
+         * Move constructor: takes over the distances of 'other', leaving it empty.
+         */
+        DistanceMatrix(DistanceMatrix&& other);
+
+        int getNumVertices() const;
+
+        /*
+         * Returns the distance from 'u' to 'v'. Throws out_of_range for invalid vertices.
+         */
+        int get(int u, int v) const;
+
+        /*
+         * Returns the getNumVertices() distances from 'u'. Throws out_of_range for an invalid vertex.
+         */
+        const int* getRow(int u) const;
+    };
+}
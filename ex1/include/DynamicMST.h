@@ -0,0 +1,119 @@
+// shirat345@gmail.com
+#pragma once
+#include "Graph.h"
+
+namespace graph {
+
+    /*
+     * DynamicMST maintains a minimum spanning forest while edges are inserted or their
+     * weights decrease, without recomputing it from scratch.
+     *
+     * By the cycle property, a new edge (u, v, w) enters the forest either when u and v are
+     * in different trees, or when the heaviest edge on the tree path u..v weighs more than w,
+     * in which case that heaviest edge leaves. Non-tree edges can never re-enter under these
+     * updates, so they are not stored.
+     *
+     * The forest is kept in a link-cut tree in which every tree edge is a node of its own,
+     * so path-maximum, link and cut all take O(log V) amortized time.
+     */
+    class DynamicMST {
+        int numVertices;
+        int numNodes;           // 1 + numVertices vertex nodes + numVertices edge nodes (index 0 is null)
+
+        // Link-cut tree (splay trees over preferred paths)
+        int* left;
+        int* right;
+        int* parent;
+        int* value;             // Edge weight for edge nodes, INT_MIN for vertex nodes
+        int* maxNode;           // Node with the largest value in the splay subtree
+        bool* reversed;         // Lazy "reverse this subtree" flag
+        int* stack;             // Scratch for pushing lazy flags down before a splay
+
+        // Tree edges, stored in edge slots 0..numVertices-1 (node = numVertices + 1 + slot)
+        int* edgeU;
+        int* edgeV;
+        int* freeSlots;         // Stack of unused slots
+        int freeCount;
+        int* firstEdge;         // Per vertex: first incident slot (-1 if none)
+        int* nextEdge;          // Per slot and endpoint (2 * slot + side): next incident slot
+
+        long long totalWeight;
+        int treeEdges;
+
+        bool isSplayRoot(int x) const;
+        void pull(int x);
+        void push(int x);
+        void rotate(int x);
+        void splay(int x);
+        void access(int x);
+        void makeRoot(int x);
+        int findRoot(int x);
+        void link(int x, int y);
+        void cut(int x, int y);
+
+        void addTreeEdge(int u, int v, int weight);
+        void removeTreeEdge(int slot);
+        int findTreeEdge(int u, int v) const;
+        void checkVertex(int v) const;
+        void allocate();
+
+    public:
+        /*
+         * Constructor: an empty forest over 'vertices' isolated vertices.
+         */
+        explicit DynamicMST(int vertices);
+
+        /*
+         * Constructor: starts from the minimum spanning forest of 'g' (computed once with Kruskal).
+         * Throws invalid_argument if 'g' is directed.
+         */
+        explicit DynamicMST(const Graph& g);
+
+        /*
+         * Destructor: frees the link-cut tree arrays.
+         */
+        ~DynamicMST();
+
+        DynamicMST(const DynamicMST&) = delete;
+        DynamicMST& operator=(const DynamicMST&) = delete;
+
+        /*
+         * Updates the forest for a newly inserted edge. Returns true if the forest changed.
+         * Throws out_of_range for invalid vertices and invalid_argument for self-loops.
+         */
+        bool insertEdge(int u, int v, int weight);
+
+        /*
+         * Updates the forest after the weight of edge (u, v) decreased to 'weight'.
+         * Returns true if the forest changed.
+         * Throws invalid_argument if (u, v) is a tree edge and 'weight' is larger than its weight.
+         */
+        bool decreaseWeight(int u, int v, int weight);
+
+        /*
+         * Returns true if u and v are in the same tree of the forest.
+         */
+        bool connected(int u, int v);
+
+        /*
+         * Returns the largest edge weight on the tree path between u and v.
+         * Throws invalid_argument if they are not connected or u == v.
+         */
+        int pathMax(int u, int v);
+
+        /*
+         * Returns the total weight of the forest.
+         */
+        long long getTotalWeight() const;
+
+        /*
+         * Returns the number of edges in the forest.
+         */
+        int getNumTreeEdges() const;
+
+        /*
+         * Returns the forest as an undirected Graph.
+         */
+        Graph toGraph() const;
+    };
+}
@@ -0,0 +1,71 @@
+// shirat345@gmail.com
+#pragma once
+
+namespace graph {
+
+    /*
+     * EdgeBuffer stores a list of weighted edges as a structure of arrays
+     * (sources, destinations, weights) and can order them by weight.
+     *
+     * sortByWeight does not move the edges: it computes a permutation with an LSD radix sort
+     * on the 32-bit weights (8 bits per pass, passes on which all weights agree are skipped),
+     * so only the weight keys and 4-byte indices travel through memory. The sort is stable:
+     * edges of equal weight keep the order in which they were added.
+     */
+    class EdgeBuffer {
+        int* srcs;          // Source vertex of each edge
+        int* dests;         // Destination vertex of each edge
+        int* weights;       // Weight of each edge
+        int capacity;       // Current capacity of the arrays
+        int size;           // Number of edges in the buffer
+
+        /*
+         * Grows the arrays to hold at least 'edges' edges, keeping their contents.
+         */
+        void grow(int edges);
+
+    public:
+        /*
+         * Constructor: optionally pre-allocates room for 'initialCapacity' edges.
+         */
+        explicit EdgeBuffer(int initialCapacity = 0);
+
+        /*
+         * Destructor: frees the arrays.
+         */
+        ~EdgeBuffer();
+
+        EdgeBuffer(const EdgeBuffer&) = delete;
+        EdgeBuffer& operator=(const EdgeBuffer&) = delete;
+
+        /*
+         * Grows the arrays to hold at least 'edges' edges.
+         */
+        void reserve(int edges);
+
+        /*
+         * Appends the edge (src, dest) with the given weight.
+         */
+        void add(int src, int dest, int weight);
+
+        /*
+         * Removes all edges (the arrays are kept).
+         */
+        void clear();
+
+        /*
+         * Writes into 'order' (getSize() entries) the edge indices sorted by increasing
+         * weight, ties in insertion order. Negative weights are supported.
+         */
+        void sortByWeight(int* order) const;
+
+        /*
+         * Accessors.
+         */
+        int getSize() const;
+        int getSrc(int i) const;
+        int getDest(int i) const;
+        int getWeight(int i) const;
+        const int* getWeights() const;
+    };
+}
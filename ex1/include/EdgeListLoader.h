@@ -0,0 +1,47 @@
+// shirat345@gmail.com
+#pragma once
+#include "Graph.h"
+#include "CSRGraph.h"
+#include "GraphBuilder.h"
+#include <string>
+
+namespace graph {
+
+    /*
+     * EdgeListLoader reads text edge lists, one edge per line:
+     *   src dst [weight]
+     * Fields are separated by spaces or tabs, the weight defaults to 1, and lines that are
+     * empty or start with '#' or '%' are ignored.
+     *
+     * The file is read in large chunks; each chunk is split at line boundaries into one
+     * piece per thread, the pieces are parsed in parallel on ThreadPool::shared() and the results
+     * are handed to a GraphBuilder in file order, so the result does not depend on the thread count.
+     */
+    class EdgeListLoader {
+    public:
+        /*
+         * Parses the file at 'path' into 'builder'.
+         * The chunks are split into 'numThreads' pieces (0 = one per thread of the shared pool).
+         * Throws runtime_error if the file cannot be read or a line is malformed,
+         * and invalid_argument for self-loops.
+         */
+        static void load(const std::string& path, GraphBuilder& builder, int numThreads = 0);
+
+        /*
+         * Parses the file and builds a CSRGraph ('numVertices' of 0 infers it from the ids).
+         * With 'directed' each line is an edge from src to dst only.
+         */
+        static CSRGraph loadCSR(const std::string& path, int numVertices = 0, int numThreads = 0, bool directed = false);
+
+        /*
+         * Parses the file and builds a regular Graph.
+         */
+        static Graph loadGraph(const std::string& path, int numVertices = 0, int numThreads = 0, bool directed = false);
+
+        /*
+         * Parses 'length' bytes of complete lines from 'text' into 'builder' on the calling thread.
+         * Useful for in-memory data and for testing.
+         */
+        static void parse(const char* text, size_t length, GraphBuilder& builder);
+    };
+}
@@ -0,0 +1,52 @@
+// shirat345@gmail.com
+#pragma once
+#include "Graph.h"
+
+namespace graph {
+
+    /*
+     * Generators builds synthetic undirected graphs for benchmarks and load tests.
+     * Every generator is deterministic for a given seed, draws edge weights uniformly
+     * from [1, maxWeight], and collects its edges in a GraphBuilder so the graph is built
+     * in one O(V + E) pass.
+     *
+     * Throws invalid_argument for non-positive sizes or maxWeight.
+     */
+    class Generators {
+    public:
+        /*
+         * Erdős–Rényi G(n, m): 'edges' vertex pairs drawn uniformly at random.
+         * Self-loops are redrawn; repeated pairs are merged, so the graph may have slightly fewer edges.
+         */
+        static Graph erdosRenyi(int vertices, int edges, unsigned int seed, int maxWeight = 100);
+
+        /*
+         * R-MAT (recursive matrix / Kronecker): 2^scale vertices, 'edges' draws that pick one
+         * adjacency-matrix quadrant per level with probabilities a, b, c and 1 - a - b - c.
+         * The skewed defaults produce a few very high-degree hubs (around vertex 0) and a long tail.
+         * Self-loops are redrawn and repeated pairs are merged.
+         * Throws invalid_argument for invalid probabilities, including b + c == 0
+         * (no draw could ever leave the diagonal).
+         */
+        static Graph rmat(int scale, int edges, unsigned int seed, int maxWeight = 100,
+                          double a = 0.57, double b = 0.19, double c = 0.19);
+
+        /*
+         * Barabási–Albert preferential attachment: starts from a clique of edgesPerVertex + 1
+         * vertices; every further vertex connects to edgesPerVertex distinct earlier vertices
+         * chosen with probability proportional to their degree.
+         */
+        static Graph barabasiAlbert(int vertices, int edgesPerVertex, unsigned int seed, int maxWeight = 100);
+
+        /*
+         * rows x cols grid where each vertex r * cols + c is connected to its right and lower neighbor
+         * (a simple road-network-like graph with large diameter).
+         */
+        static Graph grid(int rows, int cols, unsigned int seed, int maxWeight = 100);
+
+        /*
+         * Path 0 - 1 - ... - (vertices - 1): maximal depth for traversals.
+         */
+        static Graph path(int vertices, unsigned int seed, int maxWeight = 100);
+    };
+}
@@ -1,6 +1,8 @@
 //shirat345@gmail.com
 #pragma once
 
+class UnionFind;
+
 namespace graph {
     /*
      * Represents a neighbor vertex in an adjacency list.
@@ -27,17 +29,32 @@ namespace graph {
  /*
      * Graph class using an adjacency list representation.
      * Supports directed or undirected graphs with weighted edges.
+     *
+     * Graph is not thread-safe. Several threads may only read one Graph at the same time if
+     * nobody modifies it and nobody calls connected / getNumComponents (they build their
+     * index lazily). To query a graph from many threads while it is being updated, use
+     * VersionedGraph (GraphSnapshot.h), which hands out immutable snapshots.
      */
     class Graph {
 
         int const numVertices;        // Total number of vertices in the graph
         VertexNode* adjList;          // Array of adjacency lists (one per vertex)
+        bool const directed;          // True if edges are stored in one direction only
+        int numEntries;               // Number of entries in the adjacency lists
+        VertexNode* inList;           // Reverse (in-edge) lists of a directed graph, or nullptr
+        mutable UnionFind* components; // Connected components, created on the first connectivity query
+        mutable bool componentsStale; // True after a removal, until the components are rebuilt
+
+        void rebuildComponents() const;
        
     public:
         /*
          * Constructor: initializes the graph with a given number of vertices.
+         * A directed graph stores each edge only in the list of its source vertex.
+         * 'keepInEdges' additionally maintains a reverse index of incoming edges
+         * (only meaningful for directed graphs).
          */
-        Graph(int vertices);   
+        Graph(int vertices, bool directed = false, bool keepInEdges = false);   
 
         /*
          * Destructor: cleans up dynamically allocated memory.
@@ -46,17 +63,27 @@ namespace graph {
 
         /*
          * Adds an edge from 'src' to 'dest' with an optional weight (default is 1).
-         * If the graph is undirected, you may want to call this method twice in the implementation.
+         * In an undirected graph the edge is stored in both lists; in a directed graph
+         * only in the list of 'src'.
          */
         void addEdge(int src, int dest, int weight = 1); 
 
+        /*
+         * Adds a single directed entry from 'src' to 'dest' without looking for an existing edge.
+         * Used when building trees or reloading stored graphs, where duplicates cannot occur.
+         * (The reverse index of a directed graph is kept up to date.)
+         */
+        void addTreeEdge(int src, int dest, int weight = 1);
+
         /*
          * Removes the edge from 'src' to 'dest' if it exists.
+         * In a directed graph the edge from 'dest' to 'src' is left untouched.
          */
         void removeEdge(int src, int dest);              
 
         /*
          * Prints the graph in a human-readable format (e.g., adjacency list).
+         * Use GraphWriter for other destinations and machine-readable formats.
          */
         void print_graph() const;                       
 
@@ -65,17 +92,60 @@ namespace graph {
          */
         int getNumVertices() const;
 
+        /*
+         * Returns the number of entries in the adjacency lists in O(1): the number of edges
+         * of a directed graph, twice the number of edges of an undirected one
+         * (as CSRGraph::getNumEntries). Maintained by addEdge, addTreeEdge and removeEdge.
+         */
+        int getNumEntries() const;
+
         /*
          * Returns a pointer to the adjacency list of the graph.
          */
         VertexNode* getAdjList() const;
 
+        /*
+         * Calls f(neighbor, weight) for every neighbor of 'v', in list order
+         * (the same interface as CSRGraph and DeltaGraph, for code shared between them).
+         */
+        template <typename F>
+        void forEachNeighbor(int v, F f) const {
+            for (NeighborVer* n = adjList[v].neighbors; n; n = n->next) {
+                f(n->vertex, n->weight);
+            }
+        }
+
+        /*
+         * Returns true if the graph was constructed as directed.
+         */
+        bool isDirected() const;
+
+        /*
+         * Returns the lists of incoming edges: the adjacency list itself for an undirected
+         * graph, the reverse index for a directed graph built with 'keepInEdges',
+         * and nullptr otherwise. In these lists 'vertex' is the source of the edge.
+         */
+        VertexNode* getInAdjList() const;
+
         /*
          * Checks if any edge in the graph has a negative weight.
          * Useful for validating input for algorithms like Dijkstra's.
          */
         bool hasNegativeWeights() const;
 
+        /*
+         * Returns true if 'u' and 'v' are in the same connected component
+         * (weakly connected for directed graphs).
+         * The first call builds a UnionFind over the current edges in O(V + E); after that
+         * addEdge keeps it up to date, so queries take near-constant time.
+         * A removeEdge makes the next query rebuild it, since union-find cannot split sets.
+         */
+        bool connected(int u, int v) const;
+
+        /*
+         * Returns the number of connected components, maintained like connected().
+         */
+        int getNumComponents() const;
 
 
         
@@ -0,0 +1,77 @@
+// shirat345@gmail.com
+#pragma once
+#include "Graph.h"
+#include "CSRGraph.h"
+
+namespace graph {
+
+    /*
+     * GraphBuilder collects weighted edges and builds the whole graph at once.
+     * Building is O(V + E) (a counting sort by source vertex), instead of the O(degree)
+     * duplicate scan that Graph::addEdge pays for every single edge.
+     *
+     * Duplicate edges follow Graph::addEdge semantics: the weight added last wins.
+     */
+    class GraphBuilder {
+        int* srcs;          // Source vertex of each collected edge
+        int* dests;         // Destination vertex of each collected edge
+        int* weights;       // Weight of each collected edge
+        int capacity;       // Allocated length of the three arrays
+        int size;           // Number of collected edges
+        int maxVertex;      // Largest vertex id seen so far (-1 if none)
+        bool directed;      // Build a directed graph (edges stored in the source row only)
+
+        /*
+         * Grows the arrays so that at least 'needed' edges fit.
+         */
+        void reserve(int needed);
+
+    public:
+        /*
+         * Constructor: creates an empty builder with room for 'initialCapacity' edges.
+         * 'directed' selects whether the built graph is directed.
+         */
+        GraphBuilder(int initialCapacity = 16, bool directed = false);
+
+        /*
+         * Destructor: releases the collected edges.
+         */
+        ~GraphBuilder();
+
+        GraphBuilder(const GraphBuilder&) = delete;
+        GraphBuilder& operator=(const GraphBuilder&) = delete;
+
+        /*
+         * Collects the edge (src, dest) with the given weight.
+         * Throws out_of_range for negative vertex ids and invalid_argument for self-loops.
+         */
+        void addEdge(int src, int dest, int weight = 1);
+
+        /*
+         * Collects 'count' edges from parallel arrays in one call (already validated input).
+         */
+        void addEdges(const int* src, const int* dest, const int* weight, int count);
+
+        /*
+         * Appends every edge collected by 'other', in order.
+         */
+        void append(const GraphBuilder& other);
+
+        /*
+         * Returns the number of collected edges (before removing duplicates).
+         */
+        int getNumEdges() const;
+
+        /*
+         * Builds a CSRGraph. 'numVertices' of 0 means "largest vertex id seen + 1".
+         * Throws out_of_range if an edge refers to a vertex >= numVertices,
+         * and invalid_argument if no vertices can be inferred.
+         */
+        CSRGraph build(int numVertices = 0) const;
+
+        /*
+         * Same as build(), but returns a regular Graph.
+         */
+        Graph buildGraph(int numVertices = 0) const;
+    };
+}
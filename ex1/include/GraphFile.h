@@ -0,0 +1,82 @@
+// shirat345@gmail.com
+#pragma once
+#include "Graph.h"
+#include "CSRGraph.h"
+#include <cstdint>
+#include <string>
+
+namespace graph {
+
+    /*
+     * On-disk header of a binary graph file. It is followed directly by three
+     * int32 arrays in native byte order:
+     *   offsets[numVertices + 1], targets[numEntries], weights[numEntries]
+     * which is exactly the CSRGraph layout, so the file can be used in place.
+     */
+    struct GraphFileHeader {
+        char magic[4];          // Always "EX1G"
+        uint32_t version;       // Format version (GraphFile::VERSION)
+        uint32_t headerSize;    // sizeof(GraphFileHeader) at write time
+        uint32_t flags;         // Bit 0 (GraphFile::FLAG_DIRECTED): the graph is directed; other bits are 0
+        int32_t numVertices;    // Number of vertices
+        int32_t numEntries;     // Number of adjacency entries (each undirected edge counts twice)
+    };
+
+    /*
+     * GraphFile writes graphs in the binary format described by GraphFileHeader.
+     */
+    class GraphFile {
+    public:
+        static const uint32_t VERSION = 1;
+        static const uint32_t FLAG_DIRECTED = 1;  // Header flag: the graph is directed
+
+        /*
+         * Serializes 'g' to 'path', replacing any existing file.
+         * Throws runtime_error if the file cannot be written.
+         */
+        static void write(const Graph& g, const std::string& path);
+
+        /*
+         * Serializes an already compact graph to 'path'.
+         */
+        static void write(const CSRGraph& g, const std::string& path);
+    };
+
+    /*
+     * MappedGraph memory-maps a binary graph file read-only and exposes it as a
+     * CSRGraph view without copying or parsing the edge data.
+     * The view is valid for as long as the MappedGraph object is alive.
+     */
+    class MappedGraph {
+        void* base;             // Start of the mapping
+        size_t length;          // Length of the mapping in bytes
+        CSRGraph* view;         // View over the mapped arrays
+
+    public:
+        /*
+         * Maps the file at 'path' and checks its offsets and targets in O(V + E).
+         * Throws runtime_error if the file cannot be opened, is truncated,
+         * is not a graph file of a supported version, or its arrays are corrupt
+         * (offsets out of order, targets that are not vertices).
+         */
+        explicit MappedGraph(const std::string& path);
+
+        /*
+         * Destructor: unmaps the file.
+         */
+        ~MappedGraph();
+
+        MappedGraph(const MappedGraph&) = delete;
+        MappedGraph& operator=(const MappedGraph&) = delete;
+
+        /*
+         * Returns the mapped graph. Pass it to the CSRGraph overloads in Algorithms.
+         */
+        const CSRGraph& getGraph() const;
+
+        /*
+         * Builds a regular (mutable) Graph from the mapped data.
+         */
+        Graph toGraph() const;
+    };
+}
@@ -0,0 +1,116 @@
+// shirat345@gmail.com
+#pragma once
+#include "Graph.h"
+#include "CSRGraph.h"
+#include "DeltaGraph.h"
+#include <memory>
+#include <mutex>
+
+namespace graph {
+
+    /*
+     * GraphSnapshot is a read-only handle to one version of a VersionedGraph.
+     *
+     * The version it refers to never changes and stays alive as long as any snapshot of it
+     * exists, so a snapshot can be copied to and read from any number of threads without
+     * locking. In particular the CSRGraph overloads of Algorithms (bfs, dfs, dijkstra, prim,
+     * bfsDistances) only read their input, so they may run concurrently on getGraph().
+     * Copying a snapshot costs one reference count update.
+     */
+    class GraphSnapshot {
+        friend class VersionedGraph;
+
+        /*
+         * One published version: the frozen graph and its number
+         * (1 for the initial graph, +1 per publish).
+         */
+        struct Version {
+            CSRGraph graph;
+            unsigned long long number;
+
+            Version(CSRGraph&& graph, unsigned long long number);
+        };
+
+        std::shared_ptr<const Version> data;
+
+        explicit GraphSnapshot(const std::shared_ptr<const Version>& data);
+
+    public:
+        /*
+         * Returns the graph of this version.
+         */
+        const CSRGraph& getGraph() const;
+
+        /*
+         * Returns the version number.
+         */
+        unsigned long long getVersion() const;
+
+        int getNumVertices() const;
+    };
+
+    /*
+     * VersionedGraph lets many threads query a graph while a writer keeps changing it,
+     * in the style of read-copy-update:
+     * - readers call snapshot() and work on the returned version; this never waits for the
+     *   writer, and the version does not change under them;
+     * - writers call addEdge / removeEdge, which are collected in a DeltaOverlay on top of
+     *   the current version and are invisible to readers;
+     * - publish() builds the next version from the current one plus the pending changes and
+     *   swaps it in atomically. Readers holding older snapshots keep using them; an old
+     *   version is freed when its last snapshot is released.
+     *
+     * All methods are thread-safe. Writers are serialized with each other (and with publish),
+     * but not with readers. Batching many updates per publish amortizes the O(V + E) rebuild.
+     */
+    class VersionedGraph {
+        typedef GraphSnapshot::Version Version;
+
+        std::shared_ptr<const Version> current;     // Published version (atomic load / store)
+        std::shared_ptr<const Version> pendingBase; // Version the pending changes apply to
+        DeltaOverlay* pending;                      // Owned, changes since the last publish
+        mutable std::mutex writeLock;               // Guards pendingBase and pending
+
+    public:
+        /*
+         * Constructor: the initial version is a compact copy of 'g'.
+         */
+        explicit VersionedGraph(const Graph& g);
+
+        /*
+         * Constructor: the initial version takes over 'base' (moved in).
+         */
+        explicit VersionedGraph(CSRGraph&& base);
+
+        /*
+         * Destructor: frees the pending changes; published versions live on in their snapshots.
+         */
+        ~VersionedGraph();
+
+        VersionedGraph(const VersionedGraph&) = delete;
+        VersionedGraph& operator=(const VersionedGraph&) = delete;
+
+        /*
+         * Returns the latest published version.
+         */
+        GraphSnapshot snapshot() const;
+
+        /*
+         * Same semantics and exceptions as Graph::addEdge / Graph::removeEdge.
+         * The change becomes visible to readers with the next publish().
+         */
+        void addEdge(int src, int dest, int weight = 1);
+        void removeEdge(int src, int dest);
+
+        /*
+         * Returns the number of change entries waiting for publish().
+         */
+        int getNumPendingChanges() const;
+
+        /*
+         * Makes the pending changes visible as a new version and returns it.
+         * Without pending changes the current version is returned unchanged.
+         */
+        GraphSnapshot publish();
+    };
+}
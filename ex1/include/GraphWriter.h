@@ -0,0 +1,75 @@
+// shirat345@gmail.com
+#pragma once
+#include "Graph.h"
+#include "CSRGraph.h"
+#include <cstddef>
+#include <iosfwd>
+
+namespace graph {
+
+    /*
+     * GraphWriter dumps graphs through one large output buffer, formatting integers by hand.
+     * The buffer is handed to the stream (or file descriptor) only when it fills up,
+     * on flush(), and on destruction, so a dump costs a handful of writes instead of
+     * several stream operations per edge.
+     */
+    class GraphWriter {
+    public:
+        /*
+         * Output formats:
+         * - ADJACENCY: the human-readable format of Graph::print_graph.
+         * - EDGE_LIST: one "src dst weight" line per edge (readable by EdgeListLoader).
+         * - DOT: a Graphviz graph (digraph if directed) with the weight as an edge attribute.
+         * - JSON: {"vertices": N, "directed": bool, "edges": [[src, dst, weight], ...]}.
+         * Each undirected edge appears once in every format except ADJACENCY.
+         */
+        enum Format { ADJACENCY, EDGE_LIST, DOT, JSON };
+
+        /*
+         * Constructor: writes to 'out' through a buffer of 'bufferSize' bytes.
+         */
+        explicit GraphWriter(std::ostream& out, size_t bufferSize = 1 << 16);
+
+        /*
+         * Constructor: writes to the file descriptor 'fd' (which stays open) through a buffer.
+         */
+        explicit GraphWriter(int fd, size_t bufferSize = 1 << 16);
+
+        /*
+         * Destructor: flushes whatever is still buffered.
+         */
+        ~GraphWriter();
+
+        GraphWriter(const GraphWriter&) = delete;
+        GraphWriter& operator=(const GraphWriter&) = delete;
+
+        /*
+         * Writes 'g' in the given format.
+         */
+        void write(const Graph& g, Format format = ADJACENCY);
+        void write(const CSRGraph& g, Format format = ADJACENCY);
+
+        /*
+         * Hands the buffered bytes to the stream or file descriptor.
+         * Throws runtime_error if the underlying write fails.
+         */
+        void flush();
+
+        /*
+         * Low-level appenders, usable for custom formats.
+         */
+        void put(char c);
+        void put(const char* text);
+        void putInt(int value);
+
+    private:
+        char* buffer;           // Output buffer
+        size_t capacity;        // Size of the buffer in bytes
+        size_t length;          // Bytes currently buffered
+        std::ostream* stream;   // Destination stream, or nullptr when writing to a descriptor
+        int fd;                 // Destination descriptor (used when stream is nullptr)
+
+        template <typename Rows>
+        void writeRows(const Rows& rows, Format format);
+    };
+}
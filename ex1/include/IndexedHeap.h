@@ -0,0 +1,78 @@
+// shirat345@gmail.com
+#pragma once
+
+namespace graph {
+
+    /*
+     * IndexedHeap is a binary min-heap of vertices keyed by an int, with decrease-key.
+     * Used by prim, where a vertex's key only ever goes down.
+     *
+     * Every vertex is in the heap at most once: position[v] is the slot of 'v' in the heap
+     * (-1 if it is not in it), so lowering a key moves the existing entry up instead of adding
+     * a duplicate, and the heap never holds more than 'capacity' entries.
+     * Vertices and keys are kept in two parallel arrays so a sift only touches contiguous ints.
+     *
+     * Every position is -1 whenever the heap is empty, so clear() only costs the number of
+     * vertices still in the heap and the heap can be reused across queries without an O(V) reset.
+     */
+    class IndexedHeap {
+        int capacity;       // Vertices 0 .. capacity - 1 can be stored
+        int size;           // Number of vertices currently in the heap
+        int* vertices;      // Heap order: vertices[0] has the smallest key
+        int* keys;          // keys[i] is the key of vertices[i]
+        int* position;      // Slot of each vertex in the heap, -1 if absent
+
+        /*
+         * Heap helpers: restore the order upwards / downwards from slot 'i'.
+         */
+        void siftUp(int i);
+        void siftDown(int i);
+
+    public:
+        /*
+         * Constructor: optionally pre-allocates room for vertices 0 .. vertices - 1.
+         */
+        explicit IndexedHeap(int vertices = 0);
+
+        /*
+         * Destructor: frees the arrays.
+         */
+        ~IndexedHeap();
+
+        IndexedHeap(const IndexedHeap&) = delete;
+        IndexedHeap& operator=(const IndexedHeap&) = delete;
+
+        /*
+         * Grows the arrays to hold vertices 0 .. vertices - 1. The heap must be empty.
+         */
+        void reserve(int vertices);
+
+        /*
+         * Inserts 'vertex' with 'key', or lowers its key if it is already in the heap.
+         * Returns true if the vertex was inserted, false if it was already present
+         * (its key is then only changed if 'key' is smaller).
+         * No range check: 'vertex' must be below the reserved capacity.
+         */
+        bool pushOrDecrease(int vertex, int key);
+
+        /*
+         * Removes and returns the vertex with the smallest key; its key is stored in 'key'.
+         * Throws underflow_error if the heap is empty.
+         */
+        int extractMin(int& key);
+
+        /*
+         * Returns true if 'vertex' is currently in the heap.
+         */
+        bool contains(int vertex) const;
+
+        bool isEmpty() const;
+        int getSize() const;
+        int getCapacity() const;
+
+        /*
+         * Removes all vertices, keeping the allocated capacity for reuse.
+         */
+        void clear();
+    };
+}
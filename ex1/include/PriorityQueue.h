@@ -18,23 +18,44 @@ namespace graph {
     /*
      * PriorityQueue class for managing edges based on their weights.
      * Designed for use in algorithms like Dijkstra, Prim, and Kruskal.
+     *
+     * Edges are stored as a structure of arrays (sources, destinations, weights).
+     * While the queue holds at most SMALL_QUEUE_LIMIT edges it is an unsorted array and
+     * extractMin finds the minimum with a vectorized scan of the weights (Simd::minIndex),
+     * which beats a heap for small queues. Beyond that it is turned into a binary min-heap
+     * in place, and it returns to the linear scan once it shrinks to half the limit.
      */
     class PriorityQueue {
+    public:
+        static const int SMALL_QUEUE_LIMIT = 64;
+
     private:
-        Edge* data;          // Dynamic array to store edges
-        int capacity;        // Current maximum capacity of the array
+        int* srcs;           // Source vertex of each edge
+        int* dests;          // Destination vertex of each edge
+        int* weights;        // Weight of each edge (contiguous for the vectorized scan)
+        int capacity;        // Current maximum capacity of the arrays
         int size;            // Current number of elements in the queue
+        bool heap;           // True if the arrays are currently ordered as a binary min-heap
 
         /*
-         * Doubles the capacity of the internal array when it's full.
+         * Doubles the capacity of the internal arrays when they are full.
          */
         void resize();        
 
         /*
-         * Returns the index of the edge with the smallest weight.
+         * Returns the index of the edge with the smallest weight (linear mode).
          */
         int findMinIndex() const; 
 
+        /*
+         * Heap helpers: swap two entries, restore the heap order upwards / downwards,
+         * and build a heap from the unsorted array.
+         */
+        void swapEntries(int i, int j);
+        void siftUp(int i);
+        void siftDown(int i);
+        void heapify();
+
     public:
         /*
          * Constructor: initializes the priority queue with a given capacity (default is 10).
@@ -46,6 +67,9 @@ namespace graph {
          */
         ~PriorityQueue();                       
 
+        PriorityQueue(const PriorityQueue&) = delete;
+        PriorityQueue& operator=(const PriorityQueue&) = delete;
+
         /*
          * Inserts a new edge into the queue.
          */
@@ -60,5 +84,15 @@ namespace graph {
          * Checks whether the queue is empty.
          */
         bool isEmpty() const;                      
+
+        /*
+         * Returns the number of edges in the queue.
+         */
+        int getSize() const;
+
+        /*
+         * Removes all edges, keeping the allocated capacity for reuse.
+         */
+        void clear();
     };
 }
@@ -0,0 +1,74 @@
+// shirat345@gmail.com
+#pragma once
+#include "Graph.h"
+#include "CSRGraph.h"
+
+namespace graph {
+
+    /*
+     * Reordering computes a vertex relabeling that places vertices which are visited together
+     * next to each other in memory, relabels graphs with it, and maps results back.
+     *
+     * Typical use:
+     *   Reordering order(g, Reordering::REVERSE_CUTHILL_MCKEE);
+     *   CSRGraph fast = order.apply(CSRGraph(g));
+     *   Graph tree = order.mapBack(Algorithms::bfs(order.toNew(source), fast));
+     */
+    class Reordering {
+    public:
+        /*
+         * Ordering strategies:
+         * - REVERSE_CUTHILL_MCKEE: BFS from a low-degree vertex of each component, visiting
+         *   neighbors by increasing degree, then reversed. Keeps neighbors' ids close (small bandwidth).
+         * - DEGREE_SORT: vertices by decreasing degree, so high-degree hubs share cache lines.
+         * - BFS_ORDER: plain BFS discovery order from vertex 0, then from each unvisited vertex.
+         */
+        enum Strategy { REVERSE_CUTHILL_MCKEE, DEGREE_SORT, BFS_ORDER };
+
+        /*
+         * Constructor: computes the ordering for 'g' with the given strategy.
+         */
+        Reordering(const CSRGraph& g, Strategy strategy);
+        Reordering(const Graph& g, Strategy strategy);
+
+        /*
+         * Destructor: frees the permutation arrays.
+         */
+        ~Reordering();
+
+        Reordering(const Reordering&) = delete;
+        Reordering& operator=(const Reordering&) = delete;
+
+        int getNumVertices() const;
+
+        /*
+         * Map a single vertex id between the original and the relabeled graph.
+         */
+        int toNew(int oldVertex) const;
+        int toOld(int newVertex) const;
+
+        /*
+         * Return the permutation arrays: newToOld[newId] == oldId and oldToNew[oldId] == newId.
+         */
+        const int* getNewToOld() const;
+        const int* getOldToNew() const;
+
+        /*
+         * Return a relabeled copy of 'g'. Throws invalid_argument if the vertex count differs.
+         */
+        CSRGraph apply(const CSRGraph& g) const;
+        Graph apply(const Graph& g) const;
+
+        /*
+         * Maps a graph produced on the relabeled graph (e.g. a BFS tree) back to original ids.
+         */
+        Graph mapBack(const Graph& relabeled) const;
+
+    private:
+        int numVertices;
+        int* newToOld;
+        int* oldToNew;
+
+        void compute(const CSRGraph& g, Strategy strategy);
+    };
+}
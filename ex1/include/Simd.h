@@ -0,0 +1,57 @@
+// shirat345@gmail.com
+#pragma once
+#include <cstdint>
+
+namespace graph {
+
+    /*
+     * Simd provides the vectorized inner loops used by the compact (CSR) code paths.
+     * Each kernel has a scalar, an AVX2 and an AVX-512 version; the best one the CPU supports
+     * is chosen at run time on first use, so the same binary runs on any x86-64 machine
+     * (and non-x86 builds only contain the scalar versions).
+     */
+    class Simd {
+    public:
+        enum Level { SCALAR, AVX2, AVX512 };
+
+        /*
+         * Returns the best level supported by this CPU / the level currently in use.
+         */
+        static Level supportedLevel();
+        static Level getLevel();
+
+        /*
+         * Forces a level (e.g. to compare implementations). Levels the CPU does not support
+         * are lowered to the best supported one. Not meant to be called while kernels run.
+         */
+        static void setLevel(Level level);
+
+        static const char* name(Level level);
+
+        /*
+         * Returns true if any of values[0 .. count) is negative.
+         */
+        static bool anyNegative(const int* values, int count);
+
+        /*
+         * Returns the index of the first smallest value of values[0 .. count), or -1 if count is 0.
+         */
+        static int minIndex(const int* values, int count);
+
+        /*
+         * BFS frontier step on bitmaps of 'words' 64-bit words:
+         * next[i] &= ~visited[i], then visited[i] |= next[i].
+         * Returns the number of bits left in 'next' (the newly visited vertices).
+         */
+        static long long frontierUpdate(uint64_t* next, uint64_t* visited, int words);
+
+        /*
+         * Min-plus row update of shortest path algorithms (Floyd-Warshall):
+         * row[j] = min(row[j], offset + through[j]) for j in [0, count), skipping entries
+         * where through[j] is INT_MAX (unreachable). 'offset' must not be INT_MAX.
+         * Sums that do not fit in an int saturate: above INT_MAX they leave row[j] unchanged,
+         * below INT_MIN they become INT_MIN.
+         */
+        static void minPlusRow(int* row, const int* through, int offset, int count);
+    };
+}
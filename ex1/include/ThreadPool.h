@@ -0,0 +1,168 @@
+// shirat345@gmail.com
+#pragma once
+#include "CSRGraph.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace graph {
+
+    /*
+     * ThreadPool runs data-parallel loops for the parallel parts of the library.
+     * All of them share ThreadPool::shared(), so running several parallel features never
+     * creates more threads than the pool has.
+     *
+     * A pool of N threads starts N - 1 workers; the thread calling parallelFor is the N-th.
+     * parallelFor cuts the range into chunks of 'grain' indices and hands every thread a
+     * contiguous block of chunks. Threads take chunks from the front of their own block and,
+     * once it is empty, steal the upper half of the largest remaining block of another
+     * thread (work stealing), so uneven chunks (e.g. high-degree vertices) still balance.
+     *
+     * The body receives [begin, end) and the index of the running thread in 0 .. N - 1,
+     * which selects its per-thread scratch (see PerThread). Calls made from inside a body,
+     * and calls while another thread's loop is running on the same pool, run on the
+     * calling thread alone / wait their turn, so nested use never deadlocks.
+     * The first exception thrown by a body is rethrown by parallelFor after all threads stop.
+     */
+    class ThreadPool {
+    public:
+        typedef std::function<void(int begin, int end, int thread)> RangeBody;
+
+    private:
+        /*
+         * Block of chunk indices [front, back) owned by one thread.
+         * Padded so the blocks of different threads do not share a cache line.
+         */
+        struct Block {
+            std::mutex lock;
+            int front;
+            int back;
+            char padding[64];
+        };
+
+        int numThreads;                 // Workers + the calling thread
+        std::thread* workers;           // numThreads - 1 worker threads
+        Block* blocks;                  // One block per thread (0 is the caller)
+
+        std::mutex lock;                // Guards the job fields below
+        std::condition_variable wake;   // Signals workers that a job started or the pool stops
+        std::condition_variable done;   // Signals the caller that the last worker left the job
+        std::mutex jobLock;             // Serializes parallelFor calls from different threads
+        unsigned long long jobId;       // Incremented for every job
+        bool stopping;
+        int busyWorkers;                // Workers still inside the current job
+
+        // Current job
+        const RangeBody* body;
+        int jobBegin;
+        int jobEnd;
+        int jobGrain;
+        std::atomic<bool> failed;
+        std::exception_ptr error;
+
+        void workerLoop(int thread, bool pin);
+        void runChunks(int thread);
+        bool takeChunk(int thread, int& chunk);
+        bool steal(int thread);
+
+    public:
+        /*
+         * Constructor: starts a pool of 'numThreads' threads in total (0 = hardware threads).
+         * With 'pinThreads' worker t is bound to CPU core t (modulo the core count) where the
+         * platform supports it.
+         */
+        explicit ThreadPool(int numThreads = 0, bool pinThreads = false);
+
+        /*
+         * Destructor: stops and joins the workers.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /*
+         * Returns the number of threads taking part in a loop, including the caller.
+         */
+        int getNumThreads() const;
+
+        /*
+         * Calls body(b, e, thread) for consecutive sub-ranges covering [begin, end),
+         * each at most 'grain' indices long (grain <= 0 picks one automatically).
+         */
+        void parallelFor(int begin, int end, int grain, const RangeBody& body);
+
+        /*
+         * parallelFor over the vertices of 'g' with sub-ranges of roughly 'edgesPerChunk'
+         * adjacency entries each, instead of a fixed number of vertices, so the work per
+         * chunk stays even on skewed degree distributions. The body receives vertex ranges.
+         */
+        void parallelForEdges(const CSRGraph& g, int edgesPerChunk, const RangeBody& body);
+
+        /*
+         * Returns the pool shared by all algorithms. It is created on first use with the
+         * thread count from the EX1_THREADS environment variable, or all hardware threads.
+         */
+        static ThreadPool& shared();
+
+        /*
+         * Replaces the shared pool by one with the given settings.
+         * Must not be called while the shared pool is running a loop.
+         */
+        static void configureShared(int numThreads, bool pinThreads = false);
+
+        /*
+         * Returns the index of the calling thread in the loop it is running,
+         * or 0 outside of any loop.
+         */
+        static int currentThread();
+    };
+
+    /*
+     * PerThread holds one T per thread of a pool (scratch buffers, partial results), each on
+     * its own cache lines. Index it with the thread argument of the loop body.
+     */
+    template <typename T>
+    class PerThread {
+        struct Slot {
+            T value;
+            char padding[64];
+        };
+
+        int count;
+        Slot* slots;
+
+    public:
+        explicit PerThread(const ThreadPool& pool = ThreadPool::shared())
+            : count(pool.getNumThreads()), slots(new Slot[pool.getNumThreads()]()) {}
+
+        ~PerThread() {
+            delete[] slots;
+        }
+
+        PerThread(const PerThread&) = delete;
+        PerThread& operator=(const PerThread&) = delete;
+
+        T& operator[](int thread) {
+            return slots[thread].value;
+        }
+
+        const T& operator[](int thread) const {
+            return slots[thread].value;
+        }
+
+        /*
+         * Returns the slot of the calling thread.
+         */
+        T& local() {
+            return slots[ThreadPool::currentThread()].value;
+        }
+
+        int size() const {
+            return count;
+        }
+    };
+}
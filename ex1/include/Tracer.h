@@ -0,0 +1,103 @@
+// shirat345@gmail.com
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace graph {
+
+    /*
+     * Tracer receives the duration of every phase of the Graph versions of bfs, dfs, dijkstra,
+     * prim and kruskal. Phases are:
+     * - "validate": argument checks (including the negative weight scan of dijkstra),
+     * - "init": workspace / queue setup,
+     * - "search": the main loop,
+     * - "build": construction of the returned tree Graph.
+     *
+     * Install an implementation with Tracer::setTracer. onPhase is called on the thread that runs
+     * the algorithm, so implementations shared between threads must synchronize themselves.
+     * When no tracer is installed each phase costs a single atomic load.
+     */
+    class Tracer {
+    public:
+        virtual ~Tracer() {}
+
+        /*
+         * Called when a phase ends. 'startNs' is measured from a fixed process-wide origin
+         * (see Tracer::now), 'durationNs' is the phase length. Both strings are literals.
+         */
+        virtual void onPhase(const char* algorithm, const char* phase, long long startNs, long long durationNs) = 0;
+
+        /*
+         * Installs 'tracer' for all threads (nullptr disables tracing) / returns the installed one.
+         * The tracer must stay alive until it is uninstalled and running calls have finished.
+         */
+        static void setTracer(Tracer* tracer);
+        static Tracer* getTracer();
+
+        /*
+         * Nanoseconds since the process-wide trace origin (steady clock).
+         */
+        static long long now();
+    };
+
+    /*
+     * PhaseTrace reports consecutive phases of one algorithm call to the installed tracer:
+     * the constructor starts the first phase, next() ends the current phase and starts another,
+     * and the destructor ends the last one (also when an exception leaves the call).
+     */
+    class PhaseTrace {
+        Tracer* tracer;
+        const char* algorithm;
+        const char* phase;
+        long long start;
+
+    public:
+        PhaseTrace(const char* algorithm, const char* firstPhase);
+        ~PhaseTrace();
+
+        PhaseTrace(const PhaseTrace&) = delete;
+        PhaseTrace& operator=(const PhaseTrace&) = delete;
+
+        void next(const char* nextPhase);
+    };
+
+    /*
+     * Tracer that records every phase and writes them in the Chrome trace event format,
+     * which can be opened in chrome://tracing or Perfetto. Safe to share between threads.
+     */
+    class ChromeTraceExporter : public Tracer {
+        struct Event {
+            const char* algorithm;
+            const char* phase;
+            long long startNs;
+            long long durationNs;
+            int thread;
+        };
+
+        mutable std::mutex mutex;
+        std::vector<Event> events;
+
+    public:
+        void onPhase(const char* algorithm, const char* phase, long long startNs, long long durationNs) override;
+
+        /*
+         * Returns the number of recorded phases / drops all of them.
+         */
+        size_t getNumEvents() const;
+        void clear();
+
+        /*
+         * Writes {"traceEvents": [...]} with one complete ("X") event per phase: the phase is the
+         * event name, the algorithm its category, timestamps are in microseconds.
+         */
+        void write(std::ostream& out) const;
+
+        /*
+         * Writes the trace to 'path'. Throws runtime_error if the file cannot be written.
+         */
+        void save(const std::string& path) const;
+    };
+}
@@ -6,6 +6,10 @@ private:
     int* parent;  // Array to store the parent of each element. Each element points to its root.
     int* rank;    // Array to store the rank (or depth) of each tree in the union-find structure, used for optimization.
     int size;     // The total number of elements in the union-find structure.
+    int sets;     // The current number of disjoint sets.
+
+    // findRoot: Recursive part of find (path compression).
+    int findRoot(int x);
 
 public:
     // Constructor: Initializes the union-find structure with 'n' elements.
@@ -22,5 +26,12 @@ public:
 
     // unionSets: Merges the sets containing elements 'x' and 'y' into a single set.
     // The set with the larger rank becomes the parent of the smaller rank set to keep the tree balanced.
-    void unionSets(int x, int y);
+    // Returns true if two different sets were merged.
+    bool unionSets(int x, int y);
+
+    // connected: Returns true if 'x' and 'y' are in the same set.
+    bool connected(int x, int y);
+
+    // getNumSets: Returns the current number of disjoint sets.
+    int getNumSets() const;
 };
@@ -0,0 +1,96 @@
+// shirat345@gmail.com
+#include "AlgorithmWorkspace.h"
+#include "AllocationTracker.h"
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+namespace graph {
+
+    // Constructor: allocates the arrays for 'vertices' vertices (possibly none yet)
+    AlgorithmWorkspace::AlgorithmWorkspace(int vertices)
+        : capacity(0), numVertices(0), generation(0), reached(nullptr), settled(nullptr),
+          dist(nullptr), parent(nullptr), order(nullptr), visit(nullptr), weight(nullptr), cursor(nullptr) {
+        reserve(vertices);
+    }
+
+    // Destructor: frees the arrays
+    AlgorithmWorkspace::~AlgorithmWorkspace() {
+        delete[] reached;
+        delete[] settled;
+        delete[] dist;
+        delete[] parent;
+        delete[] order;
+        delete[] visit;
+        delete[] weight;
+        delete[] cursor;
+    }
+
+    // reserve: reallocates the arrays if they are too small.
+    // Stamps are zeroed once here; generation numbers start at 1, so nothing counts as reached.
+    void AlgorithmWorkspace::reserve(int vertices) {
+        EX1_ALLOC_SCOPE(WORKSPACE);
+        if (vertices <= capacity) return;
+
+        vertexHeap.clear();
+        vertexHeap.reserve(vertices);
+
+        delete[] reached;
+        delete[] settled;
+        delete[] dist;
+        delete[] parent;
+        delete[] order;
+        delete[] visit;
+        delete[] weight;
+        delete[] cursor;
+        reached = new unsigned int[vertices]();
+        settled = new unsigned int[vertices]();
+        dist = new int[vertices];
+        parent = new int[vertices];
+        order = new int[vertices];
+        visit = new int[vertices];
+        weight = new int[vertices];
+        cursor = new NeighborVer*[vertices];
+        capacity = vertices;
+        generation = 0;
+        numVertices = 0;
+    }
+
+    // begin: starts a new query in O(1), except when growing or when the generation wraps around
+    void AlgorithmWorkspace::begin(int vertices) {
+        reserve(vertices);
+        if (generation == UINT_MAX) {
+            std::memset(reached, 0, sizeof(unsigned int) * capacity);
+            std::memset(settled, 0, sizeof(unsigned int) * capacity);
+            generation = 0;
+        }
+        generation++;
+        numVertices = vertices;
+        heap.clear();
+        vertexHeap.clear();
+    }
+
+    // Returns the current capacity
+    int AlgorithmWorkspace::getCapacity() const {
+        return capacity;
+    }
+
+    // Returns true if v was reached by the last query
+    bool AlgorithmWorkspace::wasReached(int v) const {
+        if (v < 0 || v >= numVertices) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+        return generation != 0 && reached[v] == generation;
+    }
+
+    // Returns the per-vertex result of the last query
+    int AlgorithmWorkspace::getDistance(int v) const {
+        return wasReached(v) ? dist[v] : INT_MAX;
+    }
+
+    // Returns the parent of v in the last query's tree
+    int AlgorithmWorkspace::getParent(int v) const {
+        return wasReached(v) ? parent[v] : -1;
+    }
+
+}
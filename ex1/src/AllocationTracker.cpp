@@ -0,0 +1,225 @@
+// shirat345@gmail.com
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+namespace graph {
+
+    // Block header: size and component of the allocation, padded to keep user data aligned
+    union BlockHeader {
+        struct {
+            std::size_t size;
+            int component;
+        } info;
+        std::max_align_t align;
+    };
+
+    // Global counters (zero-initialized before any allocation can happen)
+    static std::atomic<long long> allocations[AllocationTracker::NUM_COMPONENTS];
+    static std::atomic<long long> frees[AllocationTracker::NUM_COMPONENTS];
+    static std::atomic<long long> bytes[AllocationTracker::NUM_COMPONENTS];
+    static std::atomic<long long> liveBytes[AllocationTracker::NUM_COMPONENTS];
+    static std::atomic<long long> peakBytes[AllocationTracker::NUM_COMPONENTS];
+    static std::atomic<long long> totalLive;
+    static std::atomic<long long> totalPeak;
+
+    // Per-thread state: active component and the algorithm call in progress
+    static thread_local int currentComponent = AllocationTracker::OTHER;
+    static thread_local int callDepth = 0;
+    static thread_local const char* callName = nullptr;
+    static thread_local long long callAllocations = 0;
+    static thread_local long long callBytes = 0;
+    static thread_local long long callLive = 0;
+    static thread_local long long callPeak = 0;
+    static thread_local AllocationTracker::CallStats lastCallStats = {nullptr, 0, 0, 0};
+
+    // Raises 'peak' to 'value' if it is higher
+    static void raise(std::atomic<long long>& peak, long long value) {
+        long long seen = peak.load(std::memory_order_relaxed);
+        while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Returns true if this build tracks allocations
+    bool AllocationTracker::enabled() {
+#ifdef EX1_TRACK_ALLOC
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Allocates a block with a header and charges it to the active component
+    void* AllocationTracker::allocate(std::size_t size) {
+        BlockHeader* header = static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + size));
+        if (!header) return nullptr;
+        int c = currentComponent;
+        header->info.size = size;
+        header->info.component = c;
+
+        long long n = static_cast<long long>(size);
+        allocations[c].fetch_add(1, std::memory_order_relaxed);
+        bytes[c].fetch_add(n, std::memory_order_relaxed);
+        raise(peakBytes[c], liveBytes[c].fetch_add(n, std::memory_order_relaxed) + n);
+        raise(totalPeak, totalLive.fetch_add(n, std::memory_order_relaxed) + n);
+        if (callDepth > 0) {
+            callAllocations++;
+            callBytes += n;
+            callLive += n;
+            if (callLive > callPeak) callPeak = callLive;
+        }
+        return header + 1;
+    }
+
+    // Frees a block allocated by allocate, charging the component it was allocated for
+    void AllocationTracker::release(void* p) {
+        if (!p) return;
+        BlockHeader* header = static_cast<BlockHeader*>(p) - 1;
+        int c = header->info.component;
+        long long n = static_cast<long long>(header->info.size);
+        frees[c].fetch_add(1, std::memory_order_relaxed);
+        liveBytes[c].fetch_sub(n, std::memory_order_relaxed);
+        totalLive.fetch_sub(n, std::memory_order_relaxed);
+        if (callDepth > 0) {
+            callLive -= n;
+        }
+        std::free(header);
+    }
+
+    // Counters of one component
+    AllocationTracker::Counters AllocationTracker::get(Component component) {
+        Counters counters = {
+            allocations[component].load(), frees[component].load(), bytes[component].load(),
+            liveBytes[component].load(), peakBytes[component].load()
+        };
+        return counters;
+    }
+
+    // Sum over all components
+    AllocationTracker::Counters AllocationTracker::total() {
+        Counters sum = {0, 0, 0, totalLive.load(), totalPeak.load()};
+        for (int c = 0; c < NUM_COMPONENTS; c++) {
+            sum.allocations += allocations[c].load();
+            sum.frees += frees[c].load();
+            sum.bytes += bytes[c].load();
+        }
+        return sum;
+    }
+
+    // Last finished call of this thread
+    AllocationTracker::CallStats AllocationTracker::lastCall() {
+        return lastCallStats;
+    }
+
+    // Restarts the counters from the current live sizes
+    void AllocationTracker::reset() {
+        for (int c = 0; c < NUM_COMPONENTS; c++) {
+            allocations[c].store(0);
+            frees[c].store(0);
+            bytes[c].store(0);
+            peakBytes[c].store(liveBytes[c].load());
+        }
+        totalPeak.store(totalLive.load());
+    }
+
+    // Printable component name
+    const char* AllocationTracker::name(Component component) {
+        static const char* const names[NUM_COMPONENTS] = {
+            "Graph", "Queue", "PriorityQueue", "UnionFind", "Workspace", "CSR", "Algorithm", "Other"
+        };
+        return (component >= 0 && component < NUM_COMPONENTS) ? names[component] : "?";
+    }
+
+    // Prints the counters of every component
+    void AllocationTracker::report(std::ostream& out) {
+        out << std::left << std::setw(16) << "Component" << std::right
+            << std::setw(14) << "allocations" << std::setw(14) << "frees"
+            << std::setw(16) << "bytes" << std::setw(14) << "live" << std::setw(14) << "peak" << "\n";
+        for (int c = 0; c < NUM_COMPONENTS; c++) {
+            Counters k = get(static_cast<Component>(c));
+            out << std::left << std::setw(16) << name(static_cast<Component>(c)) << std::right
+                << std::setw(14) << k.allocations << std::setw(14) << k.frees
+                << std::setw(16) << k.bytes << std::setw(14) << k.liveBytes << std::setw(14) << k.peakBytes << "\n";
+        }
+        if (!enabled()) {
+            out << "(allocation tracking is disabled; build with TRACK_ALLOC=1)\n";
+        }
+    }
+
+    // Makes 'component' the active component of this thread
+    AllocationScope::AllocationScope(AllocationTracker::Component component) : previous(currentComponent) {
+        currentComponent = component;
+    }
+
+    // Restores the previous component
+    AllocationScope::~AllocationScope() {
+        currentComponent = previous;
+    }
+
+    // Starts measuring if this is the outermost call
+    AllocationCall::AllocationCall(const char* algorithm) : scope(AllocationTracker::ALGORITHM) {
+        if (callDepth++ == 0) {
+            callName = algorithm;
+            callAllocations = callBytes = callLive = callPeak = 0;
+        }
+    }
+
+    // Publishes the statistics when the outermost call ends
+    AllocationCall::~AllocationCall() {
+        if (--callDepth == 0) {
+            AllocationTracker::CallStats stats = {callName, callAllocations, callBytes, callPeak};
+            lastCallStats = stats;
+        }
+    }
+
+}
+
+#ifdef EX1_TRACK_ALLOC
+
+// Replaced global allocation functions: every allocation of the program goes through the tracker
+
+void* operator new(std::size_t size) {
+    void* p = graph::AllocationTracker::allocate(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return graph::AllocationTracker::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return graph::AllocationTracker::allocate(size);
+}
+
+void operator delete(void* p) noexcept {
+    graph::AllocationTracker::release(p);
+}
+
+void operator delete[](void* p) noexcept {
+    graph::AllocationTracker::release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    graph::AllocationTracker::release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    graph::AllocationTracker::release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    graph::AllocationTracker::release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    graph::AllocationTracker::release(p);
+}
+
+#endif
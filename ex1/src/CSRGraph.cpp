@@ -0,0 +1,128 @@
+// shirat345@gmail.com
+#include "CSRGraph.h"
+#include "Simd.h"
+#include "AllocationTracker.h"
+#include <stdexcept>
+
+namespace graph {
+
+    // Constructor: copies the adjacency lists of 'g' into three contiguous arrays.
+    // All arrays live in a single allocation: [offsets | targets | weights], sized from the
+    // entry count the graph maintains, so the lists are walked only once.
+    CSRGraph::CSRGraph(const Graph& g) : numVertices(g.getNumVertices()), numEntries(g.getNumEntries()), directed(g.isDirected()) {
+        EX1_ALLOC_SCOPE(CSR);
+        VertexNode* adjList = g.getAdjList();
+
+        storage = new int[(numVertices + 1) + 2 * numEntries];
+        int* off = storage;
+        int* tgt = storage + (numVertices + 1);
+        int* wgt = tgt + numEntries;
+
+        // Fill rows in adjacency list order
+        int pos = 0;
+        for (int i = 0; i < numVertices; i++) {
+            off[i] = pos;
+            for (NeighborVer* n = adjList[i].neighbors; n; n = n->next) {
+                tgt[pos] = n->vertex;
+                wgt[pos] = n->weight;
+                pos++;
+            }
+        }
+        off[numVertices] = pos;
+
+        offsets = off;
+        targets = tgt;
+        weights = wgt;
+    }
+
+    // Constructor: wraps arrays owned by the caller (no copy is made)
+    CSRGraph::CSRGraph(int vertices, int entries, const int* offsets, const int* targets, const int* weights, bool directed)
+        : numVertices(vertices), numEntries(entries), offsets(offsets), targets(targets), weights(weights),
+          storage(nullptr), directed(directed) {
+        if (vertices <= 0) {
+            throw std::invalid_argument("Number of vertices must be positive.");
+        }
+        if (entries < 0) {
+            throw std::invalid_argument("Number of edges cannot be negative.");
+        }
+    }
+
+    // Constructor: adopts a block allocated as [offsets | targets | weights]
+    CSRGraph::CSRGraph(int vertices, int entries, int* storage, bool directed)
+        : numVertices(vertices), numEntries(entries), storage(storage), directed(directed) {
+        offsets = storage;
+        targets = storage + (vertices + 1);
+        weights = targets + entries;
+    }
+
+    // Move constructor: steals the arrays; 'other' becomes an empty view
+    CSRGraph::CSRGraph(CSRGraph&& other)
+        : numVertices(other.numVertices), numEntries(other.numEntries), offsets(other.offsets),
+          targets(other.targets), weights(other.weights), storage(other.storage), directed(other.directed) {
+        other.numVertices = 0;
+        other.numEntries = 0;
+        other.offsets = nullptr;
+        other.targets = nullptr;
+        other.weights = nullptr;
+        other.storage = nullptr;
+    }
+
+    // Destructor: frees the arrays only when this object owns them
+    CSRGraph::~CSRGraph() {
+        delete[] storage;
+    }
+
+    // Returns the number of vertices in the graph
+    int CSRGraph::getNumVertices() const {
+        return numVertices;
+    }
+
+    // Returns the number of adjacency entries
+    int CSRGraph::getNumEntries() const {
+        return numEntries;
+    }
+
+    // Returns true if the graph is directed
+    bool CSRGraph::isDirected() const {
+        return directed;
+    }
+
+    // Returns the row offsets array (numVertices + 1 entries)
+    const int* CSRGraph::getOffsets() const {
+        return offsets;
+    }
+
+    // Returns the neighbor array
+    const int* CSRGraph::getTargets() const {
+        return targets;
+    }
+
+    // Returns the weight array
+    const int* CSRGraph::getWeights() const {
+        return weights;
+    }
+
+    // Returns the number of neighbors of vertex v
+    int CSRGraph::degree(int v) const {
+        return offsets[v + 1] - offsets[v];
+    }
+
+    // Checks whether the graph contains any negative-weight edges
+    // A single linear scan over the weight array
+    bool CSRGraph::hasNegativeWeights() const {
+        return Simd::anyNegative(weights, numEntries);  // The weights are contiguous: vectorized scan
+    }
+
+    // Rebuilds a linked-list Graph.
+    // Rows are inserted back to front so the adjacency lists keep the CSR order.
+    Graph CSRGraph::toGraph() const {
+        Graph g(numVertices, directed);
+        for (int v = 0; v < numVertices; v++) {
+            for (int i = offsets[v + 1] - 1; i >= offsets[v]; i--) {
+                g.addTreeEdge(v, targets[i], weights[i]);
+            }
+        }
+        return g;
+    }
+
+}
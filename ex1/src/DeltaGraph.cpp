@@ -0,0 +1,313 @@
+// shirat345@gmail.com
+#include "DeltaGraph.h"
+#include "GraphBuilder.h"
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace graph {
+
+    // ---------------------------------------------------------------- DeltaOverlay
+
+    // Constructor: empty change lists sized like the base
+    DeltaOverlay::DeltaOverlay(const CSRGraph* base)
+        : base(base), added(base->getNumVertices(), true), removed(base->getNumVertices(), true), changes(0) {
+    }
+
+    // Returns true if 'vertex' appears in the list
+    bool DeltaOverlay::contains(const NeighborVer* list, int vertex) {
+        for (; list; list = list->next) {
+            if (list->vertex == vertex) return true;
+        }
+        return false;
+    }
+
+    // Looks up src -> dest in the base row of src
+    bool DeltaOverlay::baseWeight(int src, int dest, int& weight) const {
+        const int* offsets = base->getOffsets();
+        const int* targets = base->getTargets();
+        for (int i = offsets[src]; i < offsets[src + 1]; i++) {
+            if (targets[i] == dest) {
+                weight = base->getWeights()[i];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Inserts or re-weights the single entry src -> dest
+    void DeltaOverlay::addDirected(int src, int dest, int weight) {
+        if (contains(removed.getAdjList()[src].neighbors, dest)) {
+            removed.removeEdge(src, dest);  // The base edge comes back
+            changes--;
+        }
+
+        int current;
+        if (baseWeight(src, dest, current) && current == weight) {
+            // The base already has this exact edge, no override needed
+            if (contains(added.getAdjList()[src].neighbors, dest)) {
+                added.removeEdge(src, dest);
+                changes--;
+            }
+            return;
+        }
+
+        if (!contains(added.getAdjList()[src].neighbors, dest)) {
+            changes++;
+        }
+        added.addEdge(src, dest, weight);  // Inserts, or updates an existing override
+    }
+
+    // Deletes the single entry src -> dest; returns false if it did not exist
+    bool DeltaOverlay::removeDirected(int src, int dest) {
+        bool existed = false;
+        if (contains(added.getAdjList()[src].neighbors, dest)) {
+            added.removeEdge(src, dest);
+            changes--;
+            existed = true;
+        }
+        int weight;
+        if (baseWeight(src, dest, weight) && !contains(removed.getAdjList()[src].neighbors, dest)) {
+            removed.addTreeEdge(src, dest, 0);  // Tombstone
+            changes++;
+            existed = true;
+        }
+        return existed;
+    }
+
+    // Adds an edge (both directions unless the base is directed)
+    void DeltaOverlay::addEdge(int src, int dest, int weight) {
+        int n = base->getNumVertices();
+        if (src < 0 || src >= n || dest < 0 || dest >= n) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+        if (src == dest) {  // Prevent adding edges to the same vertex (no loops allowed)
+            throw std::invalid_argument("This is must be simple graph.");
+        }
+        addDirected(src, dest, weight);
+        if (!base->isDirected()) {
+            addDirected(dest, src, weight);
+        }
+    }
+
+    // Removes an edge; throws if it does not exist
+    void DeltaOverlay::removeEdge(int src, int dest) {
+        int n = base->getNumVertices();
+        if (src < 0 || src >= n || dest < 0 || dest >= n) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+        if (!hasEdge(src, dest)) {
+            throw std::runtime_error("Error: Edge does not exist.");
+        }
+        removeDirected(src, dest);
+        if (!base->isDirected()) {
+            removeDirected(dest, src);
+        }
+    }
+
+    // Returns true if the merged graph has src -> dest
+    bool DeltaOverlay::hasEdge(int src, int dest) const {
+        if (contains(added.getAdjList()[src].neighbors, dest)) return true;
+        int weight;
+        return baseWeight(src, dest, weight) && !contains(removed.getAdjList()[src].neighbors, dest);
+    }
+
+    // Returns the number of change entries
+    int DeltaOverlay::getNumChanges() const {
+        return changes;
+    }
+
+    // Returns the base graph
+    const CSRGraph& DeltaOverlay::getBase() const {
+        return *base;
+    }
+
+    // Builds the merged graph as a new CSRGraph
+    CSRGraph DeltaOverlay::build() const {
+        int n = base->getNumVertices();
+        bool directed = base->isDirected();
+        GraphBuilder builder(base->getNumEntries() + changes + 1, directed);
+        for (int v = 0; v < n; v++) {
+            forEachNeighbor(v, [&](int u, int weight) {
+                if (directed || v < u) {  // Each undirected edge is collected once
+                    builder.addEdges(&v, &u, &weight, 1);
+                }
+            });
+        }
+        return builder.build(n);
+    }
+
+    // ---------------------------------------------------------------- DeltaGraph
+
+    // Constructor: compact copy of 'g' as the base
+    DeltaGraph::DeltaGraph(const Graph& g)
+        : numVertices(g.getNumVertices()), directed(g.isDirected()), base(new CSRGraph(g)),
+          logSize(0), logCapacity(16), stopping(false) {
+        overlay = new DeltaOverlay(base);
+        log = new Operation[logCapacity];
+    }
+
+    // Constructor: adopts an existing compact graph as the base
+    DeltaGraph::DeltaGraph(CSRGraph&& csr)
+        : numVertices(csr.getNumVertices()), directed(csr.isDirected()), base(new CSRGraph(std::move(csr))),
+          logSize(0), logCapacity(16), stopping(false) {
+        overlay = new DeltaOverlay(base);
+        log = new Operation[logCapacity];
+    }
+
+    // Destructor: stops the compactor, then frees everything
+    DeltaGraph::~DeltaGraph() {
+        stopBackgroundCompaction();
+        delete overlay;
+        delete base;
+        delete[] log;
+    }
+
+    // Returns the number of vertices
+    int DeltaGraph::getNumVertices() const {
+        return numVertices;
+    }
+
+    // Returns true if the graph is directed
+    bool DeltaGraph::isDirected() const {
+        return directed;
+    }
+
+    // Records an applied update so it can be replayed after a concurrent compaction
+    void DeltaGraph::appendLog(int src, int dest, int weight, bool remove) {
+        if (logSize == logCapacity) {
+            Operation* bigger = new Operation[logCapacity * 2];
+            std::memcpy(bigger, log, sizeof(Operation) * logSize);
+            delete[] log;
+            log = bigger;
+            logCapacity *= 2;
+        }
+        log[logSize++] = Operation{src, dest, weight, remove};
+    }
+
+    // Adds an edge to the delta
+    void DeltaGraph::addEdge(int src, int dest, int weight) {
+        std::lock_guard<std::mutex> guard(lock);
+        overlay->addEdge(src, dest, weight);
+        appendLog(src, dest, weight, false);
+    }
+
+    // Removes an edge through the delta
+    void DeltaGraph::removeEdge(int src, int dest) {
+        std::lock_guard<std::mutex> guard(lock);
+        overlay->removeEdge(src, dest);
+        appendLog(src, dest, 0, true);
+    }
+
+    // Returns true if the edge exists
+    bool DeltaGraph::hasEdge(int src, int dest) const {
+        std::lock_guard<std::mutex> guard(lock);
+        if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) {
+            return false;
+        }
+        return overlay->hasEdge(src, dest);
+    }
+
+    // Returns the number of pending change entries
+    int DeltaGraph::getDeltaSize() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return overlay->getNumChanges();
+    }
+
+    // Locks the graph for a consistent read
+    std::unique_lock<std::mutex> DeltaGraph::lockForRead() const {
+        return std::unique_lock<std::mutex>(lock);
+    }
+
+    // Returns a merged compact copy
+    CSRGraph DeltaGraph::snapshot() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return overlay->build();
+    }
+
+    // Folds the delta into a new base in three steps:
+    // 1. Under the lock, copy the log (the delta is a replay of it over the base).
+    // 2. Without the lock, replay the copy over the old base and build the new base.
+    //    The old base cannot disappear meanwhile, since only a compaction frees it.
+    // 3. Under the lock, install the new base and replay the updates that arrived during step 2.
+    void DeltaGraph::compact() {
+        std::lock_guard<std::mutex> serial(compactionLock);
+
+        std::unique_lock<std::mutex> guard(lock);
+        int snapshotSize = logSize;
+        if (snapshotSize == 0) return;
+        Operation* ops = new Operation[snapshotSize];
+        std::memcpy(ops, log, sizeof(Operation) * snapshotSize);
+        const CSRGraph* oldBase = base;
+        guard.unlock();
+
+        CSRGraph* newBase;
+        {
+            DeltaOverlay replay(oldBase);
+            for (int i = 0; i < snapshotSize; i++) {
+                if (ops[i].remove) {
+                    replay.removeEdge(ops[i].src, ops[i].dest);
+                } else {
+                    replay.addEdge(ops[i].src, ops[i].dest, ops[i].weight);
+                }
+            }
+            newBase = new CSRGraph(replay.build());
+        }
+        delete[] ops;
+
+        guard.lock();
+        DeltaOverlay* fresh = new DeltaOverlay(newBase);
+        for (int i = snapshotSize; i < logSize; i++) {
+            if (log[i].remove) {
+                fresh->removeEdge(log[i].src, log[i].dest);
+            } else {
+                fresh->addEdge(log[i].src, log[i].dest, log[i].weight);
+            }
+        }
+        std::memmove(log, log + snapshotSize, sizeof(Operation) * (logSize - snapshotSize));
+        logSize -= snapshotSize;
+        delete overlay;
+        delete base;
+        overlay = fresh;
+        base = newBase;
+    }
+
+    // Body of the background thread
+    void DeltaGraph::compactLoop(int threshold, int intervalMillis) {
+        std::unique_lock<std::mutex> guard(lock);
+        while (!stopping) {
+            wakeup.wait_for(guard, std::chrono::milliseconds(intervalMillis));
+            if (stopping) break;
+            if (overlay->getNumChanges() > 0 && overlay->getNumChanges() >= threshold) {
+                guard.unlock();
+                compact();
+                guard.lock();
+            }
+        }
+    }
+
+    // Starts periodic background compaction
+    void DeltaGraph::startBackgroundCompaction(int threshold, int intervalMillis) {
+        if (compactor.joinable()) {
+            throw std::logic_error("Background compaction is already running.");
+        }
+        if (intervalMillis <= 0) {
+            throw std::invalid_argument("Compaction interval must be positive.");
+        }
+        stopping = false;
+        compactor = std::thread(&DeltaGraph::compactLoop, this, threshold, intervalMillis);
+    }
+
+    // Stops the background thread and waits for it
+    void DeltaGraph::stopBackgroundCompaction() {
+        if (!compactor.joinable()) return;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        compactor.join();
+    }
+
+}
@@ -0,0 +1,56 @@
+// shirat345@gmail.com
+#include "DistanceMatrix.h"
+#include "AllocationTracker.h"
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+namespace graph {
+
+    // Constructor: allocates V * V distances, all unreachable
+    DistanceMatrix::DistanceMatrix(int vertices) : numVertices(vertices), data(nullptr) {
+        if (vertices < 0) {
+            throw std::invalid_argument("Number of vertices must be non-negative.");
+        }
+        EX1_ALLOC_SCOPE(ALGORITHM);
+        size_t cells = static_cast<size_t>(vertices) * static_cast<size_t>(vertices);
+        data = new int[cells > 0 ? cells : 1];
+        std::fill(data, data + cells, INT_MAX);
+    }
+
+    // Destructor
+    DistanceMatrix::~DistanceMatrix() {
+        delete[] data;
+    }
+
+    // Move constructor
+    DistanceMatrix::DistanceMatrix(DistanceMatrix&& other) : numVertices(other.numVertices), data(other.data) {
+        other.numVertices = 0;
+        other.data = nullptr;
+    }
+
+    int* DistanceMatrix::row(int u) {
+        return data + static_cast<size_t>(u) * static_cast<size_t>(numVertices);
+    }
+
+    int DistanceMatrix::getNumVertices() const {
+        return numVertices;
+    }
+
+    // Returns one distance
+    int DistanceMatrix::get(int u, int v) const {
+        if (u < 0 || u >= numVertices || v < 0 || v >= numVertices) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+        return data[static_cast<size_t>(u) * static_cast<size_t>(numVertices) + v];
+    }
+
+    // Returns the distances from 'u'
+    const int* DistanceMatrix::getRow(int u) const {
+        if (u < 0 || u >= numVertices) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+        return data + static_cast<size_t>(u) * static_cast<size_t>(numVertices);
+    }
+
+}
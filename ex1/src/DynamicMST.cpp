@@ -0,0 +1,342 @@
+// shirat345@gmail.com
+#include "DynamicMST.h"
+#include "Algorithms.h"
+#include <climits>
+#include <stdexcept>
+
+namespace graph {
+
+    // Allocates and initializes all arrays for numVertices vertices
+    void DynamicMST::allocate() {
+        numNodes = 2 * numVertices + 1;
+        left = new int[numNodes]();
+        right = new int[numNodes]();
+        parent = new int[numNodes]();
+        value = new int[numNodes];
+        maxNode = new int[numNodes];
+        reversed = new bool[numNodes]();
+        stack = new int[numNodes];
+        for (int x = 0; x < numNodes; x++) {
+            value[x] = INT_MIN;
+            maxNode[x] = x;
+        }
+
+        edgeU = new int[numVertices];
+        edgeV = new int[numVertices];
+        freeSlots = new int[numVertices];
+        freeCount = numVertices;
+        for (int s = 0; s < numVertices; s++) {
+            freeSlots[s] = numVertices - 1 - s;  // Slot 0 is handed out first
+        }
+        firstEdge = new int[numVertices];
+        nextEdge = new int[2 * numVertices];
+        for (int v = 0; v < numVertices; v++) {
+            firstEdge[v] = -1;
+        }
+        totalWeight = 0;
+        treeEdges = 0;
+    }
+
+    // Constructor: empty forest
+    DynamicMST::DynamicMST(int vertices) : numVertices(vertices) {
+        if (vertices <= 0) {
+            throw std::invalid_argument("Number of vertices must be positive.");
+        }
+        allocate();
+    }
+
+    // Constructor: starts from Kruskal's forest of g
+    DynamicMST::DynamicMST(const Graph& g) : numVertices(g.getNumVertices()) {
+        Graph forest = Algorithms::kruskal(g);  // Also rejects directed graphs
+        allocate();
+        VertexNode* adjList = forest.getAdjList();
+        for (int u = 0; u < numVertices; u++) {
+            for (NeighborVer* n = adjList[u].neighbors; n; n = n->next) {
+                if (u < n->vertex) {
+                    addTreeEdge(u, n->vertex, n->weight);
+                }
+            }
+        }
+    }
+
+    // Destructor: frees all arrays
+    DynamicMST::~DynamicMST() {
+        delete[] left;
+        delete[] right;
+        delete[] parent;
+        delete[] value;
+        delete[] maxNode;
+        delete[] reversed;
+        delete[] stack;
+        delete[] edgeU;
+        delete[] edgeV;
+        delete[] freeSlots;
+        delete[] firstEdge;
+        delete[] nextEdge;
+    }
+
+    // A node is the root of its splay tree if its parent pointer is a path-parent link
+    bool DynamicMST::isSplayRoot(int x) const {
+        int p = parent[x];
+        return p == 0 || (left[p] != x && right[p] != x);
+    }
+
+    // Recomputes the subtree maximum of x from its children
+    void DynamicMST::pull(int x) {
+        int best = x;
+        if (left[x] && value[maxNode[left[x]]] > value[best]) best = maxNode[left[x]];
+        if (right[x] && value[maxNode[right[x]]] > value[best]) best = maxNode[right[x]];
+        maxNode[x] = best;
+    }
+
+    // Pushes a pending reversal one level down
+    void DynamicMST::push(int x) {
+        if (!reversed[x]) return;
+        int tmp = left[x];
+        left[x] = right[x];
+        right[x] = tmp;
+        if (left[x]) reversed[left[x]] = !reversed[left[x]];
+        if (right[x]) reversed[right[x]] = !reversed[right[x]];
+        reversed[x] = false;
+    }
+
+    // Rotates x above its parent
+    void DynamicMST::rotate(int x) {
+        int y = parent[x];
+        int z = parent[y];
+        bool xIsLeft = (left[y] == x);
+        if (!isSplayRoot(y)) {
+            if (left[z] == y) left[z] = x; else right[z] = x;
+        }
+        parent[x] = z;
+        if (xIsLeft) {
+            left[y] = right[x];
+            if (right[x]) parent[right[x]] = y;
+            right[x] = y;
+        } else {
+            right[y] = left[x];
+            if (left[x]) parent[left[x]] = y;
+            left[x] = y;
+        }
+        parent[y] = x;
+        pull(y);
+        pull(x);
+    }
+
+    // Brings x to the root of its splay tree
+    void DynamicMST::splay(int x) {
+        int top = 0;
+        stack[top++] = x;
+        for (int y = x; !isSplayRoot(y); y = parent[y]) {
+            stack[top++] = parent[y];
+        }
+        while (top > 0) {
+            push(stack[--top]);  // Resolve lazy reversals from the top down
+        }
+        while (!isSplayRoot(x)) {
+            int y = parent[x];
+            if (!isSplayRoot(y)) {
+                int z = parent[y];
+                bool zigzig = (left[y] == x) == (left[z] == y);
+                rotate(zigzig ? y : x);
+            }
+            rotate(x);
+        }
+    }
+
+    // Makes the path from the root of x's tree to x preferred, with x at the splay root
+    void DynamicMST::access(int x) {
+        int last = 0;
+        for (int y = x; y; y = parent[y]) {
+            splay(y);
+            right[y] = last;
+            pull(y);
+            last = y;
+        }
+        splay(x);
+    }
+
+    // Re-roots x's tree at x
+    void DynamicMST::makeRoot(int x) {
+        access(x);
+        reversed[x] = !reversed[x];
+    }
+
+    // Returns the root of x's tree
+    int DynamicMST::findRoot(int x) {
+        access(x);
+        while (true) {
+            push(x);
+            if (!left[x]) break;
+            x = left[x];
+        }
+        splay(x);
+        return x;
+    }
+
+    // Links two nodes of different trees
+    void DynamicMST::link(int x, int y) {
+        makeRoot(x);
+        parent[x] = y;
+    }
+
+    // Cuts the link between two adjacent nodes
+    void DynamicMST::cut(int x, int y) {
+        makeRoot(x);
+        access(y);  // Now x is y's left child and has no right child
+        left[y] = 0;
+        parent[x] = 0;
+        pull(y);
+    }
+
+    // Adds (u, v, weight) to the forest: edge node linked between the two vertex nodes
+    void DynamicMST::addTreeEdge(int u, int v, int weight) {
+        int slot = freeSlots[--freeCount];
+        int node = numVertices + 1 + slot;
+        edgeU[slot] = u;
+        edgeV[slot] = v;
+        value[node] = weight;
+        maxNode[node] = node;
+        left[node] = right[node] = parent[node] = 0;
+        reversed[node] = false;
+        link(node, u + 1);
+        link(node, v + 1);
+
+        nextEdge[2 * slot] = firstEdge[u];
+        firstEdge[u] = 2 * slot;
+        nextEdge[2 * slot + 1] = firstEdge[v];
+        firstEdge[v] = 2 * slot + 1;
+
+        totalWeight += weight;
+        treeEdges++;
+    }
+
+    // Removes a tree edge from the link-cut tree and from the incidence lists
+    void DynamicMST::removeTreeEdge(int slot) {
+        int node = numVertices + 1 + slot;
+        int u = edgeU[slot];
+        int v = edgeV[slot];
+        cut(node, u + 1);
+        cut(node, v + 1);
+
+        int ends[2] = {u, v};
+        for (int side = 0; side < 2; side++) {
+            int* link = &firstEdge[ends[side]];
+            while (*link != 2 * slot + side) {
+                link = &nextEdge[*link];
+            }
+            *link = nextEdge[2 * slot + side];
+        }
+
+        totalWeight -= value[node];
+        value[node] = INT_MIN;
+        freeSlots[freeCount++] = slot;
+        treeEdges--;
+    }
+
+    // Returns the slot of tree edge (u, v), or -1
+    int DynamicMST::findTreeEdge(int u, int v) const {
+        for (int e = firstEdge[u]; e != -1; e = nextEdge[e]) {
+            int slot = e / 2;
+            if ((edgeU[slot] == u && edgeV[slot] == v) || (edgeU[slot] == v && edgeV[slot] == u)) {
+                return slot;
+            }
+        }
+        return -1;
+    }
+
+    // Validates a vertex index
+    void DynamicMST::checkVertex(int v) const {
+        if (v < 0 || v >= numVertices) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+    }
+
+    // Insertion: link if disconnected, otherwise swap out a heavier path maximum
+    bool DynamicMST::insertEdge(int u, int v, int weight) {
+        checkVertex(u);
+        checkVertex(v);
+        if (u == v) {
+            throw std::invalid_argument("This is must be simple graph.");
+        }
+
+        if (findRoot(u + 1) != findRoot(v + 1)) {
+            addTreeEdge(u, v, weight);
+            return true;
+        }
+
+        makeRoot(u + 1);
+        access(v + 1);
+        int heaviest = maxNode[v + 1];
+        if (value[heaviest] <= weight) {
+            return false;  // The new edge closes a cycle on which it is the heaviest
+        }
+        removeTreeEdge(heaviest - numVertices - 1);
+        addTreeEdge(u, v, weight);
+        return true;
+    }
+
+    // Weight decrease: a tree edge stays in the forest, a non-tree edge acts like an insertion
+    bool DynamicMST::decreaseWeight(int u, int v, int weight) {
+        checkVertex(u);
+        checkVertex(v);
+        int slot = findTreeEdge(u, v);
+        if (slot == -1) {
+            return insertEdge(u, v, weight);
+        }
+
+        int node = numVertices + 1 + slot;
+        if (weight > value[node]) {
+            throw std::invalid_argument("decreaseWeight cannot increase the weight of a tree edge.");
+        }
+        bool changed = (weight != value[node]);
+        splay(node);  // Node is now the root of its splay tree, so only its own maximum changes
+        totalWeight += static_cast<long long>(weight) - value[node];
+        value[node] = weight;
+        pull(node);
+        return changed;
+    }
+
+    // Returns true if both vertices are in the same tree
+    bool DynamicMST::connected(int u, int v) {
+        checkVertex(u);
+        checkVertex(v);
+        return findRoot(u + 1) == findRoot(v + 1);
+    }
+
+    // Heaviest edge weight on the tree path between u and v
+    int DynamicMST::pathMax(int u, int v) {
+        checkVertex(u);
+        checkVertex(v);
+        if (u == v || !connected(u, v)) {
+            throw std::invalid_argument("Vertices are not connected by a tree path.");
+        }
+        makeRoot(u + 1);
+        access(v + 1);
+        return value[maxNode[v + 1]];
+    }
+
+    // Returns the total weight of the forest
+    long long DynamicMST::getTotalWeight() const {
+        return totalWeight;
+    }
+
+    // Returns the number of forest edges
+    int DynamicMST::getNumTreeEdges() const {
+        return treeEdges;
+    }
+
+    // Builds an undirected Graph containing the forest edges
+    Graph DynamicMST::toGraph() const {
+        Graph forest(numVertices);
+        for (int u = 0; u < numVertices; u++) {
+            for (int e = firstEdge[u]; e != -1; e = nextEdge[e]) {
+                int slot = e / 2;
+                int other = (edgeU[slot] == u) ? edgeV[slot] : edgeU[slot];
+                forest.addTreeEdge(u, other, value[numVertices + 1 + slot]);
+            }
+        }
+        return forest;
+    }
+
+}
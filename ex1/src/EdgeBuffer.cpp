@@ -0,0 +1,150 @@
+// shirat345@gmail.com
+#include "EdgeBuffer.h"
+#include "AllocationTracker.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace graph {
+
+    // Constructor: allocates room for 'initialCapacity' edges (at least one)
+    EdgeBuffer::EdgeBuffer(int initialCapacity)
+        : srcs(nullptr), dests(nullptr), weights(nullptr), capacity(0), size(0) {
+        grow(initialCapacity > 0 ? initialCapacity : 1);
+    }
+
+    // Destructor: frees the arrays
+    EdgeBuffer::~EdgeBuffer() {
+        delete[] srcs;
+        delete[] dests;
+        delete[] weights;
+    }
+
+    // grow: reallocates the three arrays with room for 'edges' edges and copies the old contents
+    void EdgeBuffer::grow(int edges) {
+        EX1_ALLOC_SCOPE(ALGORITHM);
+        int* newSrcs = new int[edges];
+        int* newDests = new int[edges];
+        int* newWeights = new int[edges];
+        if (size > 0) {
+            std::memcpy(newSrcs, srcs, sizeof(int) * size);
+            std::memcpy(newDests, dests, sizeof(int) * size);
+            std::memcpy(newWeights, weights, sizeof(int) * size);
+        }
+        delete[] srcs;
+        delete[] dests;
+        delete[] weights;
+        srcs = newSrcs;
+        dests = newDests;
+        weights = newWeights;
+        capacity = edges;
+    }
+
+    // reserve: grows the arrays if they are too small
+    void EdgeBuffer::reserve(int edges) {
+        if (edges > capacity) {
+            grow(edges);
+        }
+    }
+
+    // add: appends an edge, doubling the capacity when the buffer is full
+    void EdgeBuffer::add(int src, int dest, int weight) {
+        if (size == capacity) {
+            grow(capacity * 2);
+        }
+        srcs[size] = src;
+        dests[size] = dest;
+        weights[size] = weight;
+        size++;
+    }
+
+    // clear: forgets all edges
+    void EdgeBuffer::clear() {
+        size = 0;
+    }
+
+    // sortByWeight: LSD radix sort of (key, index) pairs, one byte per pass.
+    // Flipping the sign bit maps signed weights to unsigned keys with the same order.
+    // All four byte histograms are counted in one sweep; a pass whose byte is the same
+    // for every key would not move anything and is skipped (small weights need one pass).
+    void EdgeBuffer::sortByWeight(int* order) const {
+        if (size == 0) return;
+        if (!order) {
+            throw std::invalid_argument("Output array must not be null.");
+        }
+        EX1_ALLOC_SCOPE(ALGORITHM);
+
+        unsigned int* keys = new unsigned int[size];
+        unsigned int* keysTmp = new unsigned int[size];
+        int* indexTmp = new int[size];
+        int counts[4][256];
+        std::memset(counts, 0, sizeof(counts));
+        for (int i = 0; i < size; i++) {
+            unsigned int key = static_cast<unsigned int>(weights[i]) ^ 0x80000000u;
+            keys[i] = key;
+            order[i] = i;
+            counts[0][key & 0xFF]++;
+            counts[1][(key >> 8) & 0xFF]++;
+            counts[2][(key >> 16) & 0xFF]++;
+            counts[3][key >> 24]++;
+        }
+
+        unsigned int* keysIn = keys;
+        unsigned int* keysOut = keysTmp;
+        int* indexIn = order;
+        int* indexOut = indexTmp;
+        for (int pass = 0; pass < 4; pass++) {
+            int shift = pass * 8;
+            int* count = counts[pass];
+            if (count[(keysIn[0] >> shift) & 0xFF] == size) continue;
+
+            // Exclusive prefix sums give the first output slot of every byte value
+            int offset = 0;
+            for (int b = 0; b < 256; b++) {
+                int c = count[b];
+                count[b] = offset;
+                offset += c;
+            }
+            for (int i = 0; i < size; i++) {
+                unsigned int key = keysIn[i];
+                int slot = count[(key >> shift) & 0xFF]++;
+                keysOut[slot] = key;
+                indexOut[slot] = indexIn[i];
+            }
+            unsigned int* keysSwap = keysIn;
+            keysIn = keysOut;
+            keysOut = keysSwap;
+            int* indexSwap = indexIn;
+            indexIn = indexOut;
+            indexOut = indexSwap;
+        }
+        if (indexIn != order) {
+            std::memcpy(order, indexIn, sizeof(int) * size);
+        }
+
+        delete[] keys;
+        delete[] keysTmp;
+        delete[] indexTmp;
+    }
+
+    // Accessors
+    int EdgeBuffer::getSize() const {
+        return size;
+    }
+
+    int EdgeBuffer::getSrc(int i) const {
+        return srcs[i];
+    }
+
+    int EdgeBuffer::getDest(int i) const {
+        return dests[i];
+    }
+
+    int EdgeBuffer::getWeight(int i) const {
+        return weights[i];
+    }
+
+    const int* EdgeBuffer::getWeights() const {
+        return weights;
+    }
+
+}
@@ -0,0 +1,184 @@
+// shirat345@gmail.com
+#include "EdgeListLoader.h"
+#include "ThreadPool.h"
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+
+namespace graph {
+
+    static const size_t CHUNK_SIZE = 16 * 1024 * 1024;  // Bytes read from the file per round
+
+    static bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    // Parses a decimal integer at 'p' and advances 'p' past it.
+    // Returns false if there is no number or it does not fit in an int.
+    static bool parseInt(const char*& p, const char* end, int& out) {
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            p++;
+        }
+        if (p >= end || *p < '0' || *p > '9') {
+            return false;
+        }
+        long long value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p - '0');
+            if (value > static_cast<long long>(INT_MAX) + 1) {
+                return false;
+            }
+            p++;
+        }
+        if (!negative && value > INT_MAX) {
+            return false;
+        }
+        out = static_cast<int>(negative ? -value : value);
+        return true;
+    }
+
+    // Parses complete lines from [text, text + length) into 'builder'
+    void EdgeListLoader::parse(const char* text, size_t length, GraphBuilder& builder) {
+        const char* p = text;
+        const char* end = text + length;
+
+        while (p < end) {
+            while (p < end && isBlank(*p)) p++;
+            if (p == end) break;
+            if (*p == '\n') {  // Empty line
+                p++;
+                continue;
+            }
+            if (*p == '#' || *p == '%') {  // Comment line
+                const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+                p = nl ? nl + 1 : end;
+                continue;
+            }
+
+            int src, dest, weight = 1;
+            bool ok = parseInt(p, end, src);
+            while (ok && p < end && isBlank(*p)) p++;
+            ok = ok && parseInt(p, end, dest);
+            while (ok && p < end && isBlank(*p)) p++;
+            if (ok && p < end && *p != '\n') {
+                ok = parseInt(p, end, weight);
+                while (ok && p < end && isBlank(*p)) p++;
+            }
+            if (!ok || (p < end && *p != '\n')) {
+                throw std::runtime_error("Malformed edge list line.");
+            }
+            builder.addEdge(src, dest, weight);
+            p++;  // Skip the newline
+        }
+    }
+
+    // Reads the file chunk by chunk and parses the pieces of every chunk on the shared pool
+    void EdgeListLoader::load(const std::string& path, GraphBuilder& builder, int numThreads) {
+        if (numThreads <= 0) {
+            numThreads = ThreadPool::shared().getNumThreads();
+        }
+
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            throw std::runtime_error("Cannot open edge list: " + path);
+        }
+
+        char* buffer = new char[CHUNK_SIZE];
+        const char** pieceBegin = new const char*[numThreads + 1];
+        std::exception_ptr* errors = new std::exception_ptr[numThreads];
+        size_t carry = 0;  // Bytes of an incomplete line kept from the previous round
+
+        try {
+            while (true) {
+                size_t n = std::fread(buffer + carry, 1, CHUNK_SIZE - carry, file);
+                size_t total = carry + n;
+                bool last = (n == 0) || std::feof(file);
+                if (std::ferror(file)) {
+                    throw std::runtime_error("Failed reading edge list: " + path);
+                }
+                if (total == 0) break;
+
+                // Only complete lines are parsed; the tail is carried into the next round
+                size_t usable = total;
+                if (!last) {
+                    while (usable > 0 && buffer[usable - 1] != '\n') usable--;
+                    if (usable == 0) {
+                        throw std::runtime_error("Edge list line is too long: " + path);
+                    }
+                }
+
+                // Split the usable bytes into one piece per thread, cutting after a newline
+                const char* end = buffer + usable;
+                pieceBegin[0] = buffer;
+                for (int t = 1; t < numThreads; t++) {
+                    const char* cut = buffer + usable * t / numThreads;
+                    if (cut < pieceBegin[t - 1]) cut = pieceBegin[t - 1];
+                    const char* nl = static_cast<const char*>(std::memchr(cut, '\n', end - cut));
+                    pieceBegin[t] = nl ? nl + 1 : end;
+                }
+                pieceBegin[numThreads] = end;
+
+                GraphBuilder* parts = new GraphBuilder[numThreads];
+                for (int t = 0; t < numThreads; t++) {
+                    errors[t] = nullptr;
+                }
+                ThreadPool::shared().parallelFor(0, numThreads, 1, [pieceBegin, parts, errors](int first, int last, int) {
+                    for (int t = first; t < last; t++) {
+                        try {
+                            parse(pieceBegin[t], pieceBegin[t + 1] - pieceBegin[t], parts[t]);
+                        } catch (...) {
+                            errors[t] = std::current_exception();
+                        }
+                    }
+                });
+
+                // Merge in file order so duplicate edges resolve deterministically
+                for (int t = 0; t < numThreads && !errors[0]; t++) {
+                    if (errors[t]) {
+                        errors[0] = errors[t];
+                        break;
+                    }
+                    builder.append(parts[t]);
+                }
+                delete[] parts;
+                if (errors[0]) {
+                    std::rethrow_exception(errors[0]);
+                }
+
+                carry = total - usable;
+                std::memmove(buffer, buffer + usable, carry);
+                if (last) break;
+            }
+        } catch (...) {
+            std::fclose(file);
+            delete[] buffer;
+            delete[] pieceBegin;
+            delete[] errors;
+            throw;
+        }
+
+        std::fclose(file);
+        delete[] buffer;
+        delete[] pieceBegin;
+        delete[] errors;
+    }
+
+    // Loads the file and builds the compact form directly
+    CSRGraph EdgeListLoader::loadCSR(const std::string& path, int numVertices, int numThreads, bool directed) {
+        GraphBuilder builder(1024, directed);
+        load(path, builder, numThreads);
+        return builder.build(numVertices);
+    }
+
+    // Loads the file and builds a linked-list Graph
+    Graph EdgeListLoader::loadGraph(const std::string& path, int numVertices, int numThreads, bool directed) {
+        GraphBuilder builder(1024, directed);
+        load(path, builder, numThreads);
+        return builder.buildGraph(numVertices);
+    }
+
+}
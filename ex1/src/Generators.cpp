@@ -0,0 +1,174 @@
+// shirat345@gmail.com
+#include "Generators.h"
+#include "GraphBuilder.h"
+#include <random>
+#include <stdexcept>
+
+namespace graph {
+
+    // Validates the common parameters
+    static void checkParameters(int vertices, int maxWeight) {
+        if (vertices <= 0) {
+            throw std::invalid_argument("Number of vertices must be positive.");
+        }
+        if (maxWeight <= 0) {
+            throw std::invalid_argument("Maximum weight must be positive.");
+        }
+    }
+
+    // Uniform integer in [0, range). The engine's raw output is used instead of a
+    // std distribution so the same seed produces the same graph with every standard library.
+    static int uniform(std::mt19937& rng, int range) {
+        return static_cast<int>(rng() % static_cast<unsigned int>(range));
+    }
+
+    // Uniform real number in [0, 1)
+    static double uniformReal(std::mt19937& rng) {
+        return rng() / 4294967296.0;
+    }
+
+    // Adds (u, v) with a random weight in [1, maxWeight]
+    static void addRandomEdge(GraphBuilder& builder, std::mt19937& rng, int u, int v, int maxWeight) {
+        builder.addEdge(u, v, 1 + uniform(rng, maxWeight));
+    }
+
+    // G(n, m): m uniformly random pairs
+    Graph Generators::erdosRenyi(int vertices, int edges, unsigned int seed, int maxWeight) {
+        checkParameters(vertices, maxWeight);
+        if (edges < 0 || (edges > 0 && vertices < 2)) {
+            throw std::invalid_argument("Invalid number of edges.");
+        }
+        std::mt19937 rng(seed);
+        GraphBuilder builder(edges > 0 ? edges : 1);
+        for (int i = 0; i < edges; i++) {
+            int u = uniform(rng, vertices);
+            int v = uniform(rng, vertices);
+            while (v == u) {
+                v = uniform(rng, vertices);
+            }
+            addRandomEdge(builder, rng, u, v, maxWeight);
+        }
+        return builder.buildGraph(vertices);
+    }
+
+    // R-MAT: each edge descends 'scale' levels of the adjacency matrix
+    Graph Generators::rmat(int scale, int edges, unsigned int seed, int maxWeight, double a, double b, double c) {
+        if (scale <= 0 || scale > 30) {
+            throw std::invalid_argument("Scale must be between 1 and 30.");
+        }
+        int vertices = 1 << scale;
+        checkParameters(vertices, maxWeight);
+        if (edges < 0) {
+            throw std::invalid_argument("Invalid number of edges.");
+        }
+        if (a < 0 || b < 0 || c < 0 || a + b + c > 1) {
+            throw std::invalid_argument("Invalid R-MAT probabilities.");
+        }
+        if (b + c <= 0) {
+            // Every draw would land on the diagonal, so self-loops would be redrawn forever
+            throw std::invalid_argument("R-MAT probabilities b and c cannot both be zero.");
+        }
+        std::mt19937 rng(seed);
+        GraphBuilder builder(edges > 0 ? edges : 1);
+        for (int i = 0; i < edges; i++) {
+            int u, v;
+            do {
+                u = 0;
+                v = 0;
+                for (int bit = scale - 1; bit >= 0; bit--) {
+                    double p = uniformReal(rng);
+                    if (p < a) {
+                        // Top-left quadrant: both bits stay 0
+                    } else if (p < a + b) {
+                        v |= 1 << bit;
+                    } else if (p < a + b + c) {
+                        u |= 1 << bit;
+                    } else {
+                        u |= 1 << bit;
+                        v |= 1 << bit;
+                    }
+                }
+            } while (u == v);
+            addRandomEdge(builder, rng, u, v, maxWeight);
+        }
+        return builder.buildGraph(vertices);
+    }
+
+    // Preferential attachment: a vertex appears in 'endpoints' once per incident edge,
+    // so a uniform draw from it picks a vertex proportionally to its degree.
+    Graph Generators::barabasiAlbert(int vertices, int edgesPerVertex, unsigned int seed, int maxWeight) {
+        checkParameters(vertices, maxWeight);
+        if (edgesPerVertex <= 0 || edgesPerVertex >= vertices) {
+            throw std::invalid_argument("edgesPerVertex must be between 1 and the number of vertices - 1.");
+        }
+        std::mt19937 rng(seed);
+        int k = edgesPerVertex;
+        long long totalEdges = static_cast<long long>(k) * (k + 1) / 2 + static_cast<long long>(vertices - k - 1) * k;
+        if (totalEdges > 1073741823) {
+            throw std::length_error("Too many edges for one graph.");
+        }
+        GraphBuilder builder(static_cast<int>(totalEdges));
+        int* endpoints = new int[2 * totalEdges];
+        int* chosen = new int[k];
+        long long count = 0;
+
+        for (int u = 0; u <= k; u++) {
+            for (int v = u + 1; v <= k; v++) {
+                addRandomEdge(builder, rng, u, v, maxWeight);
+                endpoints[count++] = u;
+                endpoints[count++] = v;
+            }
+        }
+        for (int v = k + 1; v < vertices; v++) {
+            for (int i = 0; i < k; i++) {
+                bool repeated;
+                do {
+                    chosen[i] = endpoints[rng() % static_cast<unsigned long long>(count)];
+                    repeated = false;
+                    for (int j = 0; j < i; j++) {
+                        if (chosen[j] == chosen[i]) repeated = true;
+                    }
+                } while (repeated);
+            }
+            for (int i = 0; i < k; i++) {
+                addRandomEdge(builder, rng, v, chosen[i], maxWeight);
+                endpoints[count++] = v;
+                endpoints[count++] = chosen[i];
+            }
+        }
+
+        delete[] endpoints;
+        delete[] chosen;
+        return builder.buildGraph(vertices);
+    }
+
+    // Grid: right and lower neighbor of every cell
+    Graph Generators::grid(int rows, int cols, unsigned int seed, int maxWeight) {
+        if (rows <= 0 || cols <= 0 || rows > 1073741823 / cols) {
+            throw std::invalid_argument("Number of vertices must be positive.");
+        }
+        checkParameters(rows * cols, maxWeight);
+        std::mt19937 rng(seed);
+        GraphBuilder builder(2 * rows * cols);
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) {
+                int v = r * cols + c;
+                if (c + 1 < cols) addRandomEdge(builder, rng, v, v + 1, maxWeight);
+                if (r + 1 < rows) addRandomEdge(builder, rng, v, v + cols, maxWeight);
+            }
+        }
+        return builder.buildGraph(rows * cols);
+    }
+
+    // Path: consecutive vertices
+    Graph Generators::path(int vertices, unsigned int seed, int maxWeight) {
+        checkParameters(vertices, maxWeight);
+        std::mt19937 rng(seed);
+        GraphBuilder builder(vertices);
+        for (int v = 0; v + 1 < vertices; v++) {
+            addRandomEdge(builder, rng, v, v + 1, maxWeight);
+        }
+        return builder.buildGraph(vertices);
+    }
+
+}
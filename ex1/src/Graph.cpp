@@ -1,35 +1,78 @@
 //shirat345@gmail.com
 #include "Graph.h"
+#include "AllocationTracker.h"
+#include "GraphWriter.h"
+#include "UnionFind.h"
 #include <stdexcept>
 #include <iostream>
 
 namespace graph {
 
+    // Allocates 'n' empty adjacency lists
+    static VertexNode* newLists(int n) {
+        VertexNode* lists = new VertexNode[n];  // Dynamically allocate memory for the adjacency list
+        for (int i = 0; i < n; i++) { 
+            lists[i].vertex = i;  // Assign the vertex number to the node
+            lists[i].neighbors = nullptr;  // Initialize the neighbors to nullptr
+        }
+        return lists;
+    }
+
+    // Frees 'n' adjacency lists and all their neighbor nodes
+    static void deleteLists(VertexNode* lists, int n) {
+        for (int i = 0; i < n; i++) {
+            NeighborVer* curr = lists[i].neighbors;
+            while (curr) {
+                NeighborVer* temp = curr;
+                curr = curr->next;
+                delete temp;  // Free the memory for each neighbor
+            }
+        }
+        delete[] lists;  // Free the memory for the adjacency list
+    }
+
+    // Removes 'target' from the list of vertex 'v'; returns false if it was not there
+    static bool unlinkNeighbor(VertexNode* lists, int v, int target) {
+        NeighborVer* prev = nullptr;
+        NeighborVer* curr = lists[v].neighbors;
+        while (curr) {
+            if (curr->vertex == target) {
+                if (prev == nullptr) {
+                    lists[v].neighbors = curr->next;
+                } else {
+                    prev->next = curr->next;
+                }
+                delete curr;
+                return true;
+            }
+            prev = curr;
+            curr = curr->next;
+        }
+        return false;
+    }
+
     // Constructor: Initializes the graph with a specified number of vertices
     // Throws an exception if the number of vertices is non-positive
-    Graph::Graph(int vertices): numVertices(vertices){ 
+    Graph::Graph(int vertices, bool directed, bool keepInEdges)
+        : numVertices(vertices), directed(directed), numEntries(0), inList(nullptr), components(nullptr), componentsStale(false) { 
+        EX1_ALLOC_SCOPE(GRAPH);
         if (vertices <= 0) {
             throw std::invalid_argument("Number of vertices must be positive.");
         }
-        adjList = new VertexNode[vertices];  // Dynamically allocate memory for the adjacency list
-        for (int i = 0; i < numVertices; i++) { 
-            adjList[i].vertex = i;  // Assign the vertex number to the node
-            adjList[i].neighbors = nullptr;  // Initialize the neighbors to nullptr
+        adjList = newLists(vertices);
+        if (directed && keepInEdges) {
+            inList = newLists(vertices);  // Reverse index of incoming edges
         }
     }
 
     // Destructor: Frees all dynamically allocated memory
     // Iterates through each vertex and deletes its linked list of neighbors
     Graph::~Graph() {
-        for (int i = 0; i < numVertices; i++) {
-            NeighborVer* curr = adjList[i].neighbors;
-            while (curr) {
-                NeighborVer* temp = curr;
-                curr = curr->next;
-                delete temp;  // Free the memory for each neighbor
-            }
+        deleteLists(adjList, numVertices);
+        if (inList) {
+            deleteLists(inList, numVertices);
         }
-        delete[] adjList;  // Free the memory for the adjacency list
+        delete components;
     }
 
     // Returns the number of vertices in the graph
@@ -37,21 +80,56 @@ namespace graph {
         return numVertices;
     }
 
+    // Returns the number of adjacency list entries, kept current by every edge update
+    int Graph::getNumEntries() const {
+        return numEntries;
+    }
+
     // Returns the adjacency list of the graph
     VertexNode* Graph::getAdjList() const {
         return adjList;
     }
 
-    // Adds an undirected edge between src and dest with a given weight
+    // Returns true if the graph stores edges in one direction only
+    bool Graph::isDirected() const {
+        return directed;
+    }
+
+    // Returns the incoming-edge lists (see Graph.h)
+    VertexNode* Graph::getInAdjList() const {
+        return directed ? inList : adjList;
+    }
+
+    // Adds an edge between src and dest with a given weight (undirected unless the graph is directed)
     // If the edge already exists, its weight is updated
     // Throws exceptions if the vertices are invalid or if the edge is between the same vertex
     void Graph::addEdge(int src, int dest, int weight) {
+        EX1_ALLOC_SCOPE(GRAPH);
         if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) {
             throw std::out_of_range("Invalid vertex index.");
         }
         if(src == dest){  // Prevent adding edges to the same vertex (no loops allowed)
             throw std::invalid_argument("This is must be simple graph.");
         }
+        if (directed) {
+            // Only the src -> dest entry (and its mirror in the reverse index) exists
+            for (NeighborVer* current = adjList[src].neighbors; current; current = current->next) {
+                if (current->vertex == dest) {
+                    current->weight = weight;  // Update the weight of the existing edge
+                    if (inList) {
+                        for (NeighborVer* in = inList[dest].neighbors; in; in = in->next) {
+                            if (in->vertex == src) {
+                                in->weight = weight;
+                                break;
+                            }
+                        }
+                    }
+                    return;
+                }
+            }
+            addTreeEdge(src, dest, weight);
+            return;
+        }
         // Check if the edge already exists from src to dest and update the weight if found
         NeighborVer* current = adjList[src].neighbors;
         while (current != nullptr) {
@@ -76,14 +154,51 @@ namespace graph {
 
         newNeighbor = new NeighborVer{src, weight, adjList[dest].neighbors};
         adjList[dest].neighbors = newNeighbor;
+        numEntries += 2;
+
+        if (components && !componentsStale) {
+            components->unionSets(src, dest);  // Keep the tracked components current
+        }
+    }
+
+    // Adds a one-directional entry src -> dest in O(1)
+    // Unlike addEdge, it neither scans for an existing edge nor adds the reverse entry
+    void Graph::addTreeEdge(int src, int dest, int weight) {
+        EX1_ALLOC_SCOPE(GRAPH);
+        if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+        if(src == dest){  // Prevent adding edges to the same vertex (no loops allowed)
+            throw std::invalid_argument("This is must be simple graph.");
+        }
+        adjList[src].neighbors = new NeighborVer{dest, weight, adjList[src].neighbors};
+        numEntries++;
+        if (inList) {
+            inList[dest].neighbors = new NeighborVer{src, weight, inList[dest].neighbors};
+        }
+        if (components && !componentsStale) {
+            components->unionSets(src, dest);  // Keep the tracked components current
+        }
     }
 
-    // Removes an undirected edge between src and dest
+    // Removes an undirected edge between src and dest (only src -> dest if the graph is directed)
     // Throws an error if the edge does not exist
     void Graph::removeEdge(int src, int dest){
         if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) {
             throw std::out_of_range("Invalid vertex index.");
         }
+
+        if (directed) {
+            if (!unlinkNeighbor(adjList, src, dest)) {
+                throw std::runtime_error("Error: Edge does not exist.");
+            }
+            numEntries--;
+            if (inList) {
+                unlinkNeighbor(inList, dest, src);
+            }
+            componentsStale = true;  // A removal may split a component
+            return;
+        }
         
         bool found = false;  // Flag to check if the edge is found and removed
         
@@ -99,6 +214,7 @@ namespace graph {
                     prev->next = curr->next;  // Remove the current node
                 }
                 delete curr;  // Free the memory for the edge
+                numEntries--;
                 found = true;
                 break;
             }
@@ -118,6 +234,7 @@ namespace graph {
                     prev->next = curr->next;
                 }
                 delete curr;  // Free the memory for the edge
+                numEntries--;
                 found = true;
                 break; 
             }
@@ -129,32 +246,15 @@ namespace graph {
         if (!found) {
             throw std::runtime_error("Error: Edge does not exist.");
         }
+        componentsStale = true;  // A removal may split a component
     }
 
     // Prints the adjacency list of the graph
     // Displays each vertex and its neighbors with the respective edge weights
+    // Output goes through a GraphWriter buffer and is flushed once at the end
     void Graph::print_graph() const {
-        std::cout << "vertex: (neighbor, [Edge weight])\n";
-        for (int i = 0; i < numVertices; i++) {
-            std::cout << i << ": "; 
-
-            NeighborVer* temp = adjList[i].neighbors;
-            if (!temp) {
-                std::cout << "No edges";  // If the vertex has no neighbors, print "No edges"
-            } else {
-                // Print all neighbors and their respective weights
-                while (temp) {
-                    std::cout << "(" << temp->vertex << ", [" << temp->weight << "])";
-
-                    if (temp->next) {
-                        std::cout << " - ";  // Add a separator between neighbors
-                    }
-                    temp = temp->next;
-                }
-            }
-
-            std::cout << std::endl;
-        }
+        GraphWriter writer(std::cout);
+        writer.write(*this, GraphWriter::ADJACENCY);
     }
 
     // Checks whether the graph contains any negative-weight edges
@@ -173,6 +273,36 @@ namespace graph {
         return false;  // Return false if no negative weights are found
     }
 
-}
+    // Builds the components from scratch by uniting the endpoints of every edge
+    void Graph::rebuildComponents() const {
+        UnionFind* fresh = new UnionFind(numVertices);
+        for (int i = 0; i < numVertices; i++) {
+            for (NeighborVer* n = adjList[i].neighbors; n; n = n->next) {
+                fresh->unionSets(i, n->vertex);
+            }
+        }
+        delete components;
+        components = fresh;
+        componentsStale = false;
+    }
 
+    // Checks whether u and v are in the same connected component
+    bool Graph::connected(int u, int v) const {
+        if (u < 0 || u >= numVertices || v < 0 || v >= numVertices) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+        if (!components || componentsStale) {
+            rebuildComponents();
+        }
+        return components->connected(u, v);
+    }
 
+    // Returns the number of connected components
+    int Graph::getNumComponents() const {
+        if (!components || componentsStale) {
+            rebuildComponents();
+        }
+        return components->getNumSets();
+    }
+
+}
@@ -0,0 +1,186 @@
+// shirat345@gmail.com
+#include "GraphBuilder.h"
+#include "AllocationTracker.h"
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+namespace graph {
+
+    // Constructor: allocates the edge arrays with the given initial capacity
+    GraphBuilder::GraphBuilder(int initialCapacity, bool directed)
+        : capacity(initialCapacity > 0 ? initialCapacity : 1), size(0), maxVertex(-1), directed(directed) {
+        EX1_ALLOC_SCOPE(CSR);
+        srcs = new int[capacity];
+        dests = new int[capacity];
+        weights = new int[capacity];
+    }
+
+    // Destructor: frees the edge arrays
+    GraphBuilder::~GraphBuilder() {
+        delete[] srcs;
+        delete[] dests;
+        delete[] weights;
+    }
+
+    // reserve: grows the arrays (at least doubling) until 'needed' edges fit
+    void GraphBuilder::reserve(int needed) {
+        EX1_ALLOC_SCOPE(CSR);
+        if (needed <= capacity) return;
+        int newCapacity = capacity;
+        while (newCapacity < needed) {
+            newCapacity = (newCapacity > INT_MAX / 2) ? needed : newCapacity * 2;
+        }
+        int* newSrcs = new int[newCapacity];
+        int* newDests = new int[newCapacity];
+        int* newWeights = new int[newCapacity];
+        std::memcpy(newSrcs, srcs, sizeof(int) * size);
+        std::memcpy(newDests, dests, sizeof(int) * size);
+        std::memcpy(newWeights, weights, sizeof(int) * size);
+        delete[] srcs;
+        delete[] dests;
+        delete[] weights;
+        srcs = newSrcs;
+        dests = newDests;
+        weights = newWeights;
+        capacity = newCapacity;
+    }
+
+    // Collects one edge after validating it
+    void GraphBuilder::addEdge(int src, int dest, int weight) {
+        if (src < 0 || dest < 0) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+        if (src == dest) {  // Same rule as Graph::addEdge (no loops allowed)
+            throw std::invalid_argument("This is must be simple graph.");
+        }
+        addEdges(&src, &dest, &weight, 1);
+    }
+
+    // Appends a batch of edges with a single capacity check
+    void GraphBuilder::addEdges(const int* src, const int* dest, const int* weight, int count) {
+        if (count > INT_MAX - size) {
+            throw std::length_error("Too many edges for one graph.");
+        }
+        reserve(size + count);
+        std::memcpy(srcs + size, src, sizeof(int) * count);
+        std::memcpy(dests + size, dest, sizeof(int) * count);
+        std::memcpy(weights + size, weight, sizeof(int) * count);
+        for (int i = 0; i < count; i++) {
+            if (src[i] > maxVertex) maxVertex = src[i];
+            if (dest[i] > maxVertex) maxVertex = dest[i];
+        }
+        size += count;
+    }
+
+    // Appends the edges of another builder (used to merge per-thread results)
+    void GraphBuilder::append(const GraphBuilder& other) {
+        addEdges(other.srcs, other.dests, other.weights, other.size);
+    }
+
+    // Returns the number of collected edges
+    int GraphBuilder::getNumEdges() const {
+        return size;
+    }
+
+    // Builds the CSR arrays:
+    // 1. Count the degree of every vertex (an undirected edge contributes to both endpoints).
+    // 2. Scatter the entries into their rows, keeping insertion order (counting sort).
+    // 3. Merge duplicates in each row and store the row newest-first, which is exactly
+    //    the list Graph::addEdge would have produced for the same sequence of calls.
+    CSRGraph GraphBuilder::build(int numVertices) const {
+        EX1_ALLOC_SCOPE(CSR);
+        int n = (numVertices > 0) ? numVertices : maxVertex + 1;
+        if (n <= 0) {
+            throw std::invalid_argument("Number of vertices must be positive.");
+        }
+        if (maxVertex >= n) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+        if (!directed && size > INT_MAX / 2) {
+            throw std::length_error("Too many edges for one graph.");
+        }
+
+        int entries = directed ? size : 2 * size;
+        int* start = new int[n + 1]();
+        for (int i = 0; i < size; i++) {
+            start[srcs[i] + 1]++;
+            if (!directed) start[dests[i] + 1]++;
+        }
+        for (int v = 0; v < n; v++) {
+            start[v + 1] += start[v];
+        }
+
+        int* fill = new int[n];
+        std::memcpy(fill, start, sizeof(int) * n);
+        int* rowTargets = new int[entries];
+        int* rowWeights = new int[entries];
+        for (int i = 0; i < size; i++) {
+            int a = fill[srcs[i]]++;
+            rowTargets[a] = dests[i];
+            rowWeights[a] = weights[i];
+            if (directed) continue;
+            int b = fill[dests[i]]++;
+            rowTargets[b] = srcs[i];
+            rowWeights[b] = weights[i];
+        }
+        delete[] fill;
+
+        // Merge duplicates: the first occurrence keeps its position, the last one sets the weight
+        int* seenInRow = new int[n];   // Row in which a target was last seen
+        int* slot = new int[n];        // Position of that target inside the compacted row
+        for (int v = 0; v < n; v++) {
+            seenInRow[v] = -1;
+        }
+        int* rowLength = new int[n];
+        int unique = 0;
+        for (int v = 0; v < n; v++) {
+            int out = start[v];
+            for (int i = start[v]; i < start[v + 1]; i++) {
+                int t = rowTargets[i];
+                if (seenInRow[t] == v) {
+                    rowWeights[slot[t]] = rowWeights[i];
+                } else {
+                    seenInRow[t] = v;
+                    slot[t] = out;
+                    rowTargets[out] = t;
+                    rowWeights[out] = rowWeights[i];
+                    out++;
+                }
+            }
+            rowLength[v] = out - start[v];
+            unique += rowLength[v];
+        }
+        delete[] seenInRow;
+        delete[] slot;
+
+        int* storage = new int[(n + 1) + 2 * unique];
+        int* offsets = storage;
+        int* targets = storage + (n + 1);
+        int* outWeights = targets + unique;
+        int pos = 0;
+        for (int v = 0; v < n; v++) {
+            offsets[v] = pos;
+            for (int i = start[v] + rowLength[v] - 1; i >= start[v]; i--) {  // Newest first
+                targets[pos] = rowTargets[i];
+                outWeights[pos] = rowWeights[i];
+                pos++;
+            }
+        }
+        offsets[n] = pos;
+
+        delete[] start;
+        delete[] rowLength;
+        delete[] rowTargets;
+        delete[] rowWeights;
+
+        return CSRGraph(n, unique, storage, directed);
+    }
+
+    // Builds the CSR form and converts it to a linked-list Graph
+    Graph GraphBuilder::buildGraph(int numVertices) const {
+        CSRGraph csr = build(numVertices);
+        return csr.toGraph();
+    }
+
+}
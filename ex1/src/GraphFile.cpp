@@ -0,0 +1,137 @@
+// shirat345@gmail.com
+#include "GraphFile.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace graph {
+
+    static const char GRAPH_FILE_MAGIC[4] = {'E', 'X', '1', 'G'};
+
+    // Writes a CSR graph as header + offsets + targets + weights
+    void GraphFile::write(const CSRGraph& g, const std::string& path) {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot open graph file for writing: " + path);
+        }
+
+        GraphFileHeader header;
+        std::memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+        header.version = VERSION;
+        header.headerSize = sizeof(GraphFileHeader);
+        header.flags = g.isDirected() ? FLAG_DIRECTED : 0;
+        header.numVertices = g.getNumVertices();
+        header.numEntries = g.getNumEntries();
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(g.getOffsets()), sizeof(int32_t) * (header.numVertices + 1));
+        out.write(reinterpret_cast<const char*>(g.getTargets()), sizeof(int32_t) * header.numEntries);
+        out.write(reinterpret_cast<const char*>(g.getWeights()), sizeof(int32_t) * header.numEntries);
+
+        if (!out) {
+            throw std::runtime_error("Failed writing graph file: " + path);
+        }
+    }
+
+    // Converts the graph to CSR form and writes it
+    void GraphFile::write(const Graph& g, const std::string& path) {
+        CSRGraph csr(g);
+        write(csr, path);
+    }
+
+    // Checks that the mapped arrays form a valid CSR structure, so the algorithms running on
+    // the view can index with them: offsets start at 0, never decrease and end at numEntries,
+    // and every target is a vertex
+    static bool validArrays(int numVertices, int numEntries, const int* offsets, const int* targets) {
+        if (offsets[0] != 0 || offsets[numVertices] != numEntries) {
+            return false;
+        }
+        for (int v = 0; v < numVertices; v++) {
+            if (offsets[v + 1] < offsets[v]) return false;
+        }
+        for (int i = 0; i < numEntries; i++) {
+            if (targets[i] < 0 || targets[i] >= numVertices) return false;
+        }
+        return true;
+    }
+
+    // Constructor: maps the whole file read-only and validates the header and sizes,
+    // then checks the offsets and targets in one O(V + E) pass (the weights are not touched).
+    MappedGraph::MappedGraph(const std::string& path) : base(MAP_FAILED), length(0), view(nullptr) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open graph file: " + path);
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(GraphFileHeader)) {
+            close(fd);
+            throw std::runtime_error("Graph file is truncated: " + path);
+        }
+        length = static_cast<size_t>(st.st_size);
+
+        base = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);  // The mapping stays valid after the descriptor is closed
+        if (base == MAP_FAILED) {
+            throw std::runtime_error("Cannot map graph file: " + path);
+        }
+
+        const GraphFileHeader* header = static_cast<const GraphFileHeader*>(base);
+        const char* error = nullptr;
+        if (std::memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(header->magic)) != 0) {
+            error = "Not a graph file: ";
+        } else if (header->version != GraphFile::VERSION) {
+            error = "Unsupported graph file version: ";
+        } else if (header->headerSize < sizeof(GraphFileHeader) || header->headerSize % sizeof(int32_t) != 0) {
+            error = "Corrupt graph file header: ";
+        } else if ((header->flags & ~GraphFile::FLAG_DIRECTED) != 0) {
+            error = "Unsupported graph file flags: ";
+        } else if (header->numVertices <= 0 || header->numEntries < 0) {
+            error = "Corrupt graph file header: ";
+        } else {
+            size_t expected = header->headerSize
+                + sizeof(int32_t) * (static_cast<size_t>(header->numVertices) + 1)
+                + 2 * sizeof(int32_t) * static_cast<size_t>(header->numEntries);
+            if (length < expected) {
+                error = "Graph file is truncated: ";
+            }
+        }
+        if (error) {
+            munmap(base, length);
+            throw std::runtime_error(error + path);
+        }
+
+        const int* offsets = reinterpret_cast<const int*>(static_cast<const char*>(base) + header->headerSize);
+        const int* targets = offsets + header->numVertices + 1;
+        const int* weights = targets + header->numEntries;
+        if (!validArrays(header->numVertices, header->numEntries, offsets, targets)) {
+            munmap(base, length);
+            throw std::runtime_error("Corrupt graph file: " + path);
+        }
+        view = new CSRGraph(header->numVertices, header->numEntries, offsets, targets, weights,
+                            (header->flags & GraphFile::FLAG_DIRECTED) != 0);
+    }
+
+    // Destructor: releases the view and unmaps the file
+    MappedGraph::~MappedGraph() {
+        delete view;
+        if (base != MAP_FAILED) {
+            munmap(base, length);
+        }
+    }
+
+    // Returns the zero-copy CSR view over the mapped file
+    const CSRGraph& MappedGraph::getGraph() const {
+        return *view;
+    }
+
+    // Rebuilds a linked-list Graph from the mapped arrays
+    Graph MappedGraph::toGraph() const {
+        return view->toGraph();
+    }
+
+}
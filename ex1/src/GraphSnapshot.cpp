@@ -0,0 +1,89 @@
+// shirat345@gmail.com
+#include "GraphSnapshot.h"
+#include <atomic>
+#include <utility>
+
+namespace graph {
+
+    // ---------------------------------------------------------------- GraphSnapshot
+
+    GraphSnapshot::Version::Version(CSRGraph&& graph, unsigned long long number)
+        : graph(std::move(graph)), number(number) {
+    }
+
+    GraphSnapshot::GraphSnapshot(const std::shared_ptr<const Version>& data)
+        : data(data) {
+    }
+
+    const CSRGraph& GraphSnapshot::getGraph() const {
+        return data->graph;
+    }
+
+    unsigned long long GraphSnapshot::getVersion() const {
+        return data->number;
+    }
+
+    int GraphSnapshot::getNumVertices() const {
+        return data->graph.getNumVertices();
+    }
+
+    // ---------------------------------------------------------------- VersionedGraph
+
+    // Constructor: compact copy of 'g' as version 1
+    VersionedGraph::VersionedGraph(const Graph& g)
+        : current(std::make_shared<const Version>(CSRGraph(g), 1)), pendingBase(current) {
+        pending = new DeltaOverlay(&pendingBase->graph);
+    }
+
+    // Constructor: adopts an existing compact graph as version 1
+    VersionedGraph::VersionedGraph(CSRGraph&& base)
+        : current(std::make_shared<const Version>(std::move(base), 1)), pendingBase(current) {
+        pending = new DeltaOverlay(&pendingBase->graph);
+    }
+
+    // Destructor
+    VersionedGraph::~VersionedGraph() {
+        delete pending;
+    }
+
+    // Returns the published version without taking the writer's lock. The atomic load pairs
+    // with the store in publish(), so a reader sees either the old or the new version, fully built.
+    GraphSnapshot VersionedGraph::snapshot() const {
+        return GraphSnapshot(std::atomic_load(&current));
+    }
+
+    // Records an insertion for the next version
+    void VersionedGraph::addEdge(int src, int dest, int weight) {
+        std::lock_guard<std::mutex> guard(writeLock);
+        pending->addEdge(src, dest, weight);
+    }
+
+    // Records a removal for the next version
+    void VersionedGraph::removeEdge(int src, int dest) {
+        std::lock_guard<std::mutex> guard(writeLock);
+        pending->removeEdge(src, dest);
+    }
+
+    int VersionedGraph::getNumPendingChanges() const {
+        std::lock_guard<std::mutex> guard(writeLock);
+        return pending->getNumChanges();
+    }
+
+    // Builds the next version and swaps it in; the previous one is freed by the last
+    // snapshot still holding it
+    GraphSnapshot VersionedGraph::publish() {
+        std::lock_guard<std::mutex> guard(writeLock);
+        if (pending->getNumChanges() == 0) {
+            return GraphSnapshot(pendingBase);
+        }
+
+        std::shared_ptr<const Version> next = std::make_shared<const Version>(pending->build(), pendingBase->number + 1);
+        DeltaOverlay* fresh = new DeltaOverlay(&next->graph);
+        delete pending;
+        pending = fresh;
+        pendingBase = next;
+        std::atomic_store(&current, next);
+        return GraphSnapshot(next);
+    }
+
+}
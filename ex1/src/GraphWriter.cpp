@@ -0,0 +1,214 @@
+// shirat345@gmail.com
+#include "GraphWriter.h"
+#include <cerrno>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace graph {
+
+    namespace {
+        // Row access over the linked-list Graph
+        struct ListRows {
+            const Graph& g;
+            int numVertices() const { return g.getNumVertices(); }
+            bool isDirected() const { return g.isDirected(); }
+            template <typename F>
+            void forEach(int v, F f) const {
+                for (NeighborVer* n = g.getAdjList()[v].neighbors; n; n = n->next) {
+                    f(n->vertex, n->weight);
+                }
+            }
+        };
+
+        // Row access over a CSRGraph
+        struct CSRRows {
+            const CSRGraph& g;
+            int numVertices() const { return g.getNumVertices(); }
+            bool isDirected() const { return g.isDirected(); }
+            template <typename F>
+            void forEach(int v, F f) const {
+                const int* offsets = g.getOffsets();
+                for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+                    f(g.getTargets()[i], g.getWeights()[i]);
+                }
+            }
+        };
+    }
+
+    // Constructor: buffered writer over an output stream
+    GraphWriter::GraphWriter(std::ostream& out, size_t bufferSize)
+        : capacity(bufferSize < 64 ? 64 : bufferSize), length(0), stream(&out), fd(-1) {
+        buffer = new char[capacity];
+    }
+
+    // Constructor: buffered writer over a file descriptor
+    GraphWriter::GraphWriter(int fd, size_t bufferSize)
+        : capacity(bufferSize < 64 ? 64 : bufferSize), length(0), stream(nullptr), fd(fd) {
+        buffer = new char[capacity];
+    }
+
+    // Destructor: flushes the remaining bytes (errors cannot be reported from here)
+    GraphWriter::~GraphWriter() {
+        try {
+            flush();
+        } catch (...) {
+        }
+        delete[] buffer;
+    }
+
+    // flush: sends the buffered bytes to the destination
+    void GraphWriter::flush() {
+        if (length == 0) return;
+        size_t pending = length;
+        length = 0;  // The buffer is reusable even if the write below fails
+
+        if (stream) {
+            stream->write(buffer, pending);
+            stream->flush();
+            if (!*stream) {
+                throw std::runtime_error("Failed writing graph output.");
+            }
+            return;
+        }
+
+        const char* p = buffer;
+        while (pending > 0) {
+            ssize_t written = ::write(fd, p, pending);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Failed writing graph output.");
+            }
+            p += written;
+            pending -= static_cast<size_t>(written);
+        }
+    }
+
+    // put: appends one character
+    void GraphWriter::put(char c) {
+        if (length == capacity) flush();
+        buffer[length++] = c;
+    }
+
+    // put: appends a C string
+    void GraphWriter::put(const char* text) {
+        size_t n = std::strlen(text);
+        if (length + n > capacity) flush();
+        if (n > capacity) {  // Too large to buffer, write it character by character
+            while (*text) put(*text++);
+            return;
+        }
+        std::memcpy(buffer + length, text, n);
+        length += n;
+    }
+
+    // putInt: formats a decimal integer directly into the buffer
+    void GraphWriter::putInt(int value) {
+        if (length + 12 > capacity) flush();  // "-2147483648" is 11 characters
+        char digits[12];
+        int count = 0;
+        unsigned int magnitude = value < 0 ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+        do {
+            digits[count++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+        if (value < 0) buffer[length++] = '-';
+        while (count > 0) {
+            buffer[length++] = digits[--count];
+        }
+    }
+
+    // Writes the rows in the requested format
+    template <typename Rows>
+    void GraphWriter::writeRows(const Rows& rows, Format format) {
+        int numVertices = rows.numVertices();
+        bool directed = rows.isDirected();
+        GraphWriter& w = *this;
+
+        if (format == ADJACENCY) {
+            w.put("vertex: (neighbor, [Edge weight])\n");
+            for (int v = 0; v < numVertices; v++) {
+                w.putInt(v);
+                w.put(": ");
+                bool first = true;
+                rows.forEach(v, [&](int u, int weight) {
+                    if (!first) w.put(" - ");  // Separator between neighbors
+                    first = false;
+                    w.put('(');
+                    w.putInt(u);
+                    w.put(", [");
+                    w.putInt(weight);
+                    w.put("])");
+                });
+                if (first) w.put("No edges");  // The vertex has no neighbors
+                w.put('\n');
+            }
+            return;
+        }
+
+        if (format == DOT) {
+            w.put(directed ? "digraph G {\n" : "graph G {\n");
+            for (int v = 0; v < numVertices; v++) {
+                w.put("  ");
+                w.putInt(v);
+                w.put(";\n");
+            }
+        } else if (format == JSON) {
+            w.put("{\"vertices\": ");
+            w.putInt(numVertices);
+            w.put(directed ? ", \"directed\": true" : ", \"directed\": false");
+            w.put(", \"edges\": [");
+        }
+
+        // Every undirected edge is stored in both rows; emit it from the smaller endpoint only
+        bool first = true;
+        for (int v = 0; v < numVertices; v++) {
+            rows.forEach(v, [&](int u, int weight) {
+                if (!directed && u < v) return;
+                if (format == EDGE_LIST) {
+                    w.putInt(v);
+                    w.put(' ');
+                    w.putInt(u);
+                    w.put(' ');
+                    w.putInt(weight);
+                    w.put('\n');
+                } else if (format == DOT) {
+                    w.put("  ");
+                    w.putInt(v);
+                    w.put(directed ? " -> " : " -- ");
+                    w.putInt(u);
+                    w.put(" [weight=");
+                    w.putInt(weight);
+                    w.put("];\n");
+                } else {
+                    w.put(first ? "[" : ", [");
+                    w.putInt(v);
+                    w.put(", ");
+                    w.putInt(u);
+                    w.put(", ");
+                    w.putInt(weight);
+                    w.put(']');
+                }
+                first = false;
+            });
+        }
+
+        if (format == DOT) {
+            w.put("}\n");
+        } else if (format == JSON) {
+            w.put("]}\n");
+        }
+    }
+
+    // Writes a linked-list Graph
+    void GraphWriter::write(const Graph& g, Format format) {
+        writeRows(ListRows{g}, format);
+    }
+
+    // Writes a CSRGraph
+    void GraphWriter::write(const CSRGraph& g, Format format) {
+        writeRows(CSRRows{g}, format);
+    }
+
+}
@@ -0,0 +1,133 @@
+// shirat345@gmail.com
+#include "IndexedHeap.h"
+#include "AllocationTracker.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace graph {
+
+    // Constructor: allocates the arrays for 'vertices' vertices (possibly none yet)
+    IndexedHeap::IndexedHeap(int vertices)
+        : capacity(0), size(0), vertices(nullptr), keys(nullptr), position(nullptr) {
+        reserve(vertices);
+    }
+
+    // Destructor: frees the arrays
+    IndexedHeap::~IndexedHeap() {
+        delete[] vertices;
+        delete[] keys;
+        delete[] position;
+    }
+
+    // reserve: reallocates the arrays if they are too small; all positions start at -1
+    void IndexedHeap::reserve(int count) {
+        if (count <= capacity) return;
+        if (size != 0) {
+            throw std::logic_error("Cannot grow a non-empty heap.");
+        }
+        EX1_ALLOC_SCOPE(PRIORITY_QUEUE);
+        delete[] vertices;
+        delete[] keys;
+        delete[] position;
+        vertices = new int[count];
+        keys = new int[count];
+        position = new int[count];
+        std::fill(position, position + count, -1);
+        capacity = count;
+    }
+
+    // siftUp: moves the entry at slot i up until its parent's key is not larger
+    void IndexedHeap::siftUp(int i) {
+        int vertex = vertices[i];
+        int key = keys[i];
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (keys[parent] <= key) break;
+            vertices[i] = vertices[parent];
+            keys[i] = keys[parent];
+            position[vertices[i]] = i;
+            i = parent;
+        }
+        vertices[i] = vertex;
+        keys[i] = key;
+        position[vertex] = i;
+    }
+
+    // siftDown: moves the entry at slot i down until both children's keys are not smaller
+    void IndexedHeap::siftDown(int i) {
+        int vertex = vertices[i];
+        int key = keys[i];
+        while (true) {
+            int child = 2 * i + 1;
+            if (child >= size) break;
+            if (child + 1 < size && keys[child + 1] < keys[child]) child++;
+            if (keys[child] >= key) break;
+            vertices[i] = vertices[child];
+            keys[i] = keys[child];
+            position[vertices[i]] = i;
+            i = child;
+        }
+        vertices[i] = vertex;
+        keys[i] = key;
+        position[vertex] = i;
+    }
+
+    // pushOrDecrease: inserts a new vertex at the bottom, or lowers the key of an existing one in place
+    bool IndexedHeap::pushOrDecrease(int vertex, int key) {
+        int slot = position[vertex];
+        if (slot != -1) {
+            if (key < keys[slot]) {
+                keys[slot] = key;
+                siftUp(slot);
+            }
+            return false;
+        }
+        vertices[size] = vertex;
+        keys[size] = key;
+        siftUp(size++);
+        return true;
+    }
+
+    // extractMin: removes the root and moves the last entry down from the top
+    int IndexedHeap::extractMin(int& key) {
+        if (size == 0) {
+            throw std::underflow_error("Heap is empty.");
+        }
+        int vertex = vertices[0];
+        key = keys[0];
+        position[vertex] = -1;
+        size--;
+        if (size > 0) {
+            vertices[0] = vertices[size];
+            keys[0] = keys[size];
+            siftDown(0);
+        }
+        return vertex;
+    }
+
+    // Returns true if the vertex currently has a slot
+    bool IndexedHeap::contains(int vertex) const {
+        return vertex >= 0 && vertex < capacity && position[vertex] != -1;
+    }
+
+    bool IndexedHeap::isEmpty() const {
+        return size == 0;
+    }
+
+    int IndexedHeap::getSize() const {
+        return size;
+    }
+
+    int IndexedHeap::getCapacity() const {
+        return capacity;
+    }
+
+    // clear: resets only the positions of the vertices still in the heap
+    void IndexedHeap::clear() {
+        for (int i = 0; i < size; i++) {
+            position[vertices[i]] = -1;
+        }
+        size = 0;
+    }
+
+}
@@ -1,66 +1,138 @@
 // shirat345@gmail.com
 #include "PriorityQueue.h"
+#include "AllocationTracker.h"
+#include "Simd.h"
 #include <iostream>
 
 namespace graph {
 
     // Constructor: Initializes the priority queue with a given initial capacity.
-    // Allocates memory for the queue array and sets size to 0.
+    // Allocates memory for the three arrays and sets size to 0.
     PriorityQueue::PriorityQueue(int initialCapacity)
-        : capacity(initialCapacity), size(0) {
-        data = new Edge[capacity];  // Dynamically allocate memory for the queue array
+        : capacity(initialCapacity > 0 ? initialCapacity : 1), size(0), heap(false) {
+        EX1_ALLOC_SCOPE(PRIORITY_QUEUE);
+        srcs = new int[capacity];     // Dynamically allocate memory for the queue arrays
+        dests = new int[capacity];
+        weights = new int[capacity];
     }
 
     // Destructor: Frees the dynamically allocated memory for the queue data.
     PriorityQueue::~PriorityQueue() {
-        delete[] data;  // Delete the allocated array of edges
+        delete[] srcs;
+        delete[] dests;
+        delete[] weights;
     }
 
     // resize: Doubles the capacity of the priority queue when the queue is full.
-    // Creates a new array with the doubled capacity, copies over existing data,
-    // and deletes the old array.
+    // Creates new arrays with the doubled capacity, copies over existing data,
+    // and deletes the old arrays.
     void PriorityQueue::resize() {
+        EX1_ALLOC_SCOPE(PRIORITY_QUEUE);
         int newCapacity = capacity * 2;  // Double the capacity
-        Edge* newData = new Edge[newCapacity];  // Allocate a new array with the new capacity
-        for (int i = 0; i < size; ++i)
-            newData[i] = data[i];  // Copy the existing data into the new array
-        delete[] data;  // Delete the old array
-        data = newData;  // Update the queue data pointer to the new array
+        int* newSrcs = new int[newCapacity];
+        int* newDests = new int[newCapacity];
+        int* newWeights = new int[newCapacity];
+        for (int i = 0; i < size; ++i) {
+            newSrcs[i] = srcs[i];  // Copy the existing data into the new arrays
+            newDests[i] = dests[i];
+            newWeights[i] = weights[i];
+        }
+        delete[] srcs;  // Delete the old arrays
+        delete[] dests;
+        delete[] weights;
+        srcs = newSrcs;
+        dests = newDests;
+        weights = newWeights;
         capacity = newCapacity;  // Update the capacity
     }
 
     // findMinIndex: Finds and returns the index of the edge with the minimum weight.
-    // Scans through the queue to find the minimum weight edge.
+    // The weights are contiguous, so the scan is vectorized (first minimum wins, as before).
     int PriorityQueue::findMinIndex() const {
-        int minIdx = 0;  // Assume the first element is the minimum
-        for (int i = 1; i < size; ++i) {
-            if (data[i].weight < data[minIdx].weight)  // Compare weights
-                minIdx = i;  // Update the index of the minimum weight edge
+        return Simd::minIndex(weights, size);
+    }
+
+    // swapEntries: Exchanges two entries in all three arrays.
+    void PriorityQueue::swapEntries(int i, int j) {
+        int s = srcs[i], d = dests[i], w = weights[i];
+        srcs[i] = srcs[j];
+        dests[i] = dests[j];
+        weights[i] = weights[j];
+        srcs[j] = s;
+        dests[j] = d;
+        weights[j] = w;
+    }
+
+    // siftUp: Moves entry i up while it is lighter than its parent.
+    void PriorityQueue::siftUp(int i) {
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (weights[parent] <= weights[i]) break;
+            swapEntries(i, parent);
+            i = parent;
         }
-        return minIdx;  // Return the index of the minimum weight edge
+    }
+
+    // siftDown: Moves entry i down while one of its children is lighter.
+    void PriorityQueue::siftDown(int i) {
+        while (true) {
+            int smallest = i;
+            int left = 2 * i + 1;
+            int right = left + 1;
+            if (left < size && weights[left] < weights[smallest]) smallest = left;
+            if (right < size && weights[right] < weights[smallest]) smallest = right;
+            if (smallest == i) break;
+            swapEntries(i, smallest);
+            i = smallest;
+        }
+    }
+
+    // heapify: Turns the unsorted arrays into a min-heap in O(size).
+    void PriorityQueue::heapify() {
+        for (int i = size / 2 - 1; i >= 0; --i) {
+            siftDown(i);
+        }
+        heap = true;
     }
 
     // insert: Adds a new edge to the priority queue.
-    // If the queue is full, it will resize the array to accommodate the new edge.
+    // If the queue is full, it will resize the arrays to accommodate the new edge.
+    // Crossing SMALL_QUEUE_LIMIT switches from the linear scan to a heap.
     void PriorityQueue::insert(int src, int dest, int weight) {
         if (size == capacity)  // If the queue is full, resize it
             resize();
-        data[size++] = {src, dest, weight};  // Add the new edge to the queue
+        srcs[size] = src;  // Add the new edge to the queue
+        dests[size] = dest;
+        weights[size] = weight;
+        ++size;
+        if (heap) {
+            siftUp(size - 1);
+        } else if (size > SMALL_QUEUE_LIMIT) {
+            heapify();
+        }
     }
 
     // extractMin: Removes and returns the edge with the minimum weight from the queue.
-    // The edge with the minimum weight is identified by findMinIndex.
-    // After removal, the last edge is moved to the position of the removed edge, and the size is reduced.
+    // Linear mode: the minimum is found by findMinIndex and the last edge fills its slot.
+    // Heap mode: the root is removed and the last edge sifted down from the top.
     Edge PriorityQueue::extractMin() {
         if (isEmpty()) {
             std::cerr << "PriorityQueue is empty!\n";  // Error message if the queue is empty
             return {-1, -1, -1};  // Return an invalid edge if the queue is empty
         }
 
-        int minIdx = findMinIndex();  // Find the index of the edge with the minimum weight
-        Edge minEdge = data[minIdx];  // Store the minimum edge
-        data[minIdx] = data[size - 1];  // Move the last edge to the position of the removed edge
+        int minIdx = heap ? 0 : findMinIndex();  // Find the index of the edge with the minimum weight
+        Edge minEdge = {srcs[minIdx], dests[minIdx], weights[minIdx]};  // Store the minimum edge
         --size;  // Decrease the size of the queue
+        srcs[minIdx] = srcs[size];  // Move the last edge to the position of the removed edge
+        dests[minIdx] = dests[size];
+        weights[minIdx] = weights[size];
+        if (heap) {
+            siftDown(minIdx);
+            if (size <= SMALL_QUEUE_LIMIT / 2) {
+                heap = false;  // A heap is also a valid unsorted array
+            }
+        }
         return minEdge;  // Return the minimum edge
     }
 
@@ -70,4 +142,15 @@ namespace graph {
         return size == 0;  // Return true if size is 0, meaning the queue is empty
     }
 
+    // getSize: Returns the number of edges in the queue.
+    int PriorityQueue::getSize() const {
+        return size;
+    }
+
+    // clear: Empties the queue without releasing its arrays, so it can be reused without reallocating.
+    void PriorityQueue::clear() {
+        size = 0;
+        heap = false;
+    }
+
 }
@@ -1,5 +1,6 @@
 // shirat345@gmail.com
 #include "Queue.h"
+#include "AllocationTracker.h"
 #include <iostream>
 
 // Constructor: Initializes an empty queue with front and rear pointers set to nullptr
@@ -17,6 +18,7 @@ Queue::~Queue() {
 // addNode: Adds a new node with the given value to the rear of the queue.
 // If the queue is empty, both front and rear pointers are set to the new node.
 void Queue::addNode(int value){
+    EX1_ALLOC_SCOPE(QUEUE);
     Node* newNode = new Node{value, nullptr};  // Create a new node with the given value
     if(isEmpty()){
         // If the queue is empty, both front and rear should point to the new node
@@ -0,0 +1,173 @@
+// shirat345@gmail.com
+#include "Reordering.h"
+#include "GraphBuilder.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace graph {
+
+    // Constructor: orders the vertices of a compact graph
+    Reordering::Reordering(const CSRGraph& g, Strategy strategy)
+        : numVertices(g.getNumVertices()), newToOld(new int[g.getNumVertices()]), oldToNew(new int[g.getNumVertices()]) {
+        compute(g, strategy);
+    }
+
+    // Constructor: converts to CSR once and orders it
+    Reordering::Reordering(const Graph& g, Strategy strategy)
+        : numVertices(g.getNumVertices()), newToOld(new int[g.getNumVertices()]), oldToNew(new int[g.getNumVertices()]) {
+        CSRGraph csr(g);
+        compute(csr, strategy);
+    }
+
+    // Destructor: frees the permutation
+    Reordering::~Reordering() {
+        delete[] newToOld;
+        delete[] oldToNew;
+    }
+
+    // Fills newToOld with the chosen ordering and derives oldToNew
+    void Reordering::compute(const CSRGraph& g, Strategy strategy) {
+        const int* offsets = g.getOffsets();
+        const int* targets = g.getTargets();
+        int n = numVertices;
+
+        if (strategy == DEGREE_SORT) {
+            // Counting sort by decreasing degree; ties keep increasing id order
+            int maxDegree = 0;
+            for (int v = 0; v < n; v++) {
+                if (g.degree(v) > maxDegree) maxDegree = g.degree(v);
+            }
+            int* start = new int[maxDegree + 2]();
+            for (int v = 0; v < n; v++) {
+                start[maxDegree - g.degree(v) + 1]++;
+            }
+            for (int d = 0; d <= maxDegree; d++) {
+                start[d + 1] += start[d];
+            }
+            for (int v = 0; v < n; v++) {
+                newToOld[start[maxDegree - g.degree(v)]++] = v;
+            }
+            delete[] start;
+        } else {
+            // BFS over every component. For RCM each component starts at its lowest-degree
+            // vertex and neighbors are enqueued by increasing degree.
+            bool rcm = (strategy == REVERSE_CUTHILL_MCKEE);
+            bool* visited = new bool[n]();
+            int* roots = new int[n];
+            for (int v = 0; v < n; v++) {
+                roots[v] = v;
+            }
+            if (rcm) {
+                std::stable_sort(roots, roots + n, [&g](int a, int b) { return g.degree(a) < g.degree(b); });
+            }
+
+            int head = 0, tail = 0;
+            for (int r = 0; r < n; r++) {
+                int root = roots[r];
+                if (visited[root]) continue;
+                visited[root] = true;
+                newToOld[tail++] = root;
+                while (head < tail) {
+                    int v = newToOld[head++];
+                    int firstNew = tail;
+                    for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+                        int u = targets[i];
+                        if (!visited[u]) {
+                            visited[u] = true;
+                            newToOld[tail++] = u;
+                        }
+                    }
+                    if (rcm) {
+                        std::stable_sort(newToOld + firstNew, newToOld + tail,
+                                         [&g](int a, int b) { return g.degree(a) < g.degree(b); });
+                    }
+                }
+            }
+            if (rcm) {
+                std::reverse(newToOld, newToOld + n);
+            }
+            delete[] visited;
+            delete[] roots;
+        }
+
+        for (int i = 0; i < n; i++) {
+            oldToNew[newToOld[i]] = i;
+        }
+    }
+
+    // Returns the number of vertices covered by the ordering
+    int Reordering::getNumVertices() const {
+        return numVertices;
+    }
+
+    // Maps an original id to its new id
+    int Reordering::toNew(int oldVertex) const {
+        if (oldVertex < 0 || oldVertex >= numVertices) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+        return oldToNew[oldVertex];
+    }
+
+    // Maps a new id back to the original id
+    int Reordering::toOld(int newVertex) const {
+        if (newVertex < 0 || newVertex >= numVertices) {
+            throw std::out_of_range("Invalid vertex index.");
+        }
+        return newToOld[newVertex];
+    }
+
+    // Returns the new -> old permutation
+    const int* Reordering::getNewToOld() const {
+        return newToOld;
+    }
+
+    // Returns the old -> new permutation
+    const int* Reordering::getOldToNew() const {
+        return oldToNew;
+    }
+
+    // Relabels a compact graph: row i of the result is row newToOld[i] of 'g'
+    CSRGraph Reordering::apply(const CSRGraph& g) const {
+        if (g.getNumVertices() != numVertices) {
+            throw std::invalid_argument("Graph does not match the ordering.");
+        }
+        const int* offsets = g.getOffsets();
+        const int* targets = g.getTargets();
+        const int* weights = g.getWeights();
+        bool directed = g.isDirected();
+
+        GraphBuilder builder(directed ? g.getNumEntries() : g.getNumEntries() / 2 + 1, directed);
+        for (int v = 0; v < numVertices; v++) {
+            for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+                if (directed || v < targets[i]) {
+                    int a = oldToNew[v];
+                    int b = oldToNew[targets[i]];
+                    builder.addEdges(&a, &b, &weights[i], 1);
+                }
+            }
+        }
+        return builder.build(numVertices);
+    }
+
+    // Relabels a linked-list graph
+    Graph Reordering::apply(const Graph& g) const {
+        CSRGraph relabeled = apply(CSRGraph(g));
+        return relabeled.toGraph();
+    }
+
+    // Maps every entry of a relabeled graph back to original ids
+    Graph Reordering::mapBack(const Graph& relabeled) const {
+        if (relabeled.getNumVertices() != numVertices) {
+            throw std::invalid_argument("Graph does not match the ordering.");
+        }
+        Graph original(numVertices, relabeled.isDirected());
+        VertexNode* adjList = relabeled.getAdjList();
+        for (int v = 0; v < numVertices; v++) {
+            for (NeighborVer* n = adjList[v].neighbors; n; n = n->next) {
+                original.addTreeEdge(newToOld[v], newToOld[n->vertex], n->weight);
+            }
+        }
+        return original;
+    }
+
+}
@@ -0,0 +1,527 @@
+// shirat345@gmail.com
+// Distance-oriented shortest path algorithms of Algorithms: single-source distances,
+// Bellman-Ford / SPFA for negative weights and all-pairs shortest paths.
+#include "Algorithms.h"
+#include "AlgorithmWorkspace.h"
+#include "ThreadPool.h"
+#include "Simd.h"
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+
+namespace graph {
+
+    // Side of the square tiles of the blocked Floyd-Warshall: three 64 x 64 int tiles
+    // (48 KB) stay in the L2 cache while one tile is relaxed through another two.
+    static const int FLOYD_WARSHALL_TILE = 64;
+
+    // AUTO prefers Floyd-Warshall while V^2 <= entries * log2(V) * this factor: a relaxation
+    // in a Floyd-Warshall tile is one lane of a vectorized min-plus update, a Dijkstra relaxation
+    // a heap operation, which costs roughly this many times more (measured on random graphs
+    // of 500 to 1500 vertices with AVX2 / AVX-512).
+    static const int FLOYD_WARSHALL_ADVANTAGE = 32;
+
+    /*
+    * Relaxes the tile rows [iBegin, iEnd) x columns [jBegin, jEnd) through the
+    * intermediate vertices [kBegin, kEnd) of an n x n row-major matrix:
+    *   d[i][j] = min(d[i][j], d[i][k] + d[k][j]).
+    * k is the outer loop, so the tile may overlap the rows or columns of k (the diagonal
+    * and the row / column tiles of the blocked algorithm). Each row segment is one vectorized
+    * Simd::minPlusRow call.
+    */
+    static void relaxTile(int* d, size_t n, int iBegin, int iEnd, int jBegin, int jEnd, int kBegin, int kEnd) {
+        for (int k = kBegin; k < kEnd; k++) {
+            const int* rowK = d + k * n;
+            for (int i = iBegin; i < iEnd; i++) {
+                int* rowI = d + i * n;
+                int dik = rowI[k];
+                if (dik == INT_MAX) continue;
+                Simd::minPlusRow(rowI + jBegin, rowK + jBegin, dik, jEnd - jBegin);
+            }
+        }
+    }
+
+    /*
+    * Blocked Floyd-Warshall over the tiles of d. For every block of intermediate vertices kb:
+    * 1. the diagonal tile (kb, kb) is relaxed through itself,
+    * 2. the other tiles of row kb and column kb are relaxed through the diagonal tile (parallel),
+    * 3. all remaining tiles are relaxed through their row / column tiles of step 2 (parallel).
+    */
+    static void floydWarshall(int* d, int n) {
+        const int tile = FLOYD_WARSHALL_TILE;
+        int numTiles = (n + tile - 1) / tile;
+        ThreadPool& pool = ThreadPool::shared();
+        size_t stride = static_cast<size_t>(n);
+
+        for (int kb = 0; kb < numTiles; kb++) {
+            int kBegin = kb * tile;
+            int kEnd = kBegin + tile < n ? kBegin + tile : n;
+            relaxTile(d, stride, kBegin, kEnd, kBegin, kEnd, kBegin, kEnd);
+
+            pool.parallelFor(0, 2 * numTiles, 1, [&](int first, int last, int) {
+                for (int t = first; t < last; t++) {
+                    int b = t % numTiles;
+                    if (b == kb) continue;
+                    int begin = b * tile;
+                    int end = begin + tile < n ? begin + tile : n;
+                    if (t < numTiles) {
+                        relaxTile(d, stride, kBegin, kEnd, begin, end, kBegin, kEnd);  // Row kb
+                    } else {
+                        relaxTile(d, stride, begin, end, kBegin, kEnd, kBegin, kEnd);  // Column kb
+                    }
+                }
+            });
+
+            pool.parallelFor(0, numTiles * numTiles, 1, [&](int first, int last, int) {
+                for (int t = first; t < last; t++) {
+                    int ib = t / numTiles;
+                    int jb = t % numTiles;
+                    if (ib == kb || jb == kb) continue;
+                    int iBegin = ib * tile;
+                    int jBegin = jb * tile;
+                    relaxTile(d, stride, iBegin, iBegin + tile < n ? iBegin + tile : n,
+                              jBegin, jBegin + tile < n ? jBegin + tile : n, kBegin, kEnd);
+                }
+            });
+        }
+    }
+
+    /*
+    * Lazy-deletion Dijkstra writing distances straight into 'dist'; the workspace provides
+    * the settled stamps and the heap, so repeated calls allocate nothing.
+    */
+    void Algorithms::dijkstraRow(int startVertex, const CSRGraph& g, int* dist, AlgorithmWorkspace& ws) {
+        int numVertices = g.getNumVertices();
+        const int* offsets = g.getOffsets();
+        const int* targets = g.getTargets();
+        const int* weights = g.getWeights();
+        ws.begin(numVertices);
+        unsigned int generation = ws.generation;
+        PriorityQueue& heap = ws.heap;
+
+        for (int v = 0; v < numVertices; v++) {
+            dist[v] = INT_MAX;
+        }
+        dist[startVertex] = 0;
+        heap.insert(-1, startVertex, 0);
+
+        while (!heap.isEmpty()) {
+            Edge e = heap.extractMin();
+            int u = e.dest;
+            if (ws.settled[u] == generation) continue;  // Stale entry
+            ws.settled[u] = generation;
+
+            long long du = dist[u];
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                int v = targets[i];
+                long long candidate = du + weights[i];  // Distances beyond INT_MAX never improve dist[v]
+                if (ws.settled[v] != generation && candidate < dist[v]) {
+                    dist[v] = static_cast<int>(candidate);
+                    heap.insert(u, v, dist[v]);
+                }
+            }
+        }
+    }
+
+    /*
+    * Shortest distances from one vertex over a compact graph.
+    *
+    * Throws:
+    * - invalid_argument if the graph contains negative weights.
+    * - out_of_range if the start vertex is invalid.
+    */
+    void Algorithms::dijkstraDistances(int startVertex, const CSRGraph& g, int* dist) {
+        if (startVertex < 0 || startVertex >= g.getNumVertices()) {
+            throw std::out_of_range("Start vertex is out of valid range.");
+        }
+        if (g.hasNegativeWeights()) {
+            throw std::invalid_argument("The graph contains edges with negative weights! Dijkstra's algorithm cannot operate on such a graph.");
+        }
+        AlgorithmWorkspace ws(g.getNumVertices());
+        dijkstraRow(startVertex, g, dist, ws);
+    }
+
+    // Packs a distance and a parent into one word whose unsigned order is the order of the
+    // distances (the sign bit is flipped), so the parallel variant can update both atomically
+    static uint64_t packDistance(int dist, int parent) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(dist) ^ 0x80000000u) << 32) | static_cast<uint32_t>(parent);
+    }
+
+    static int unpackDistance(uint64_t packed) {
+        return static_cast<int>(static_cast<uint32_t>(packed >> 32) ^ 0x80000000u);
+    }
+
+    static int unpackParent(uint64_t packed) {
+        return static_cast<int>(static_cast<uint32_t>(packed));
+    }
+
+    // du + w taken in 64 bits: a sum above INT_MAX stays above every int distance, so it is
+    // never stored; a sum below INT_MIN is clamped to INT_MIN instead of wrapping positive.
+    static long long relaxedDistance(int du, int w) {
+        long long sum = static_cast<long long>(du) + w;
+        return sum < INT_MIN ? INT_MIN : sum;
+    }
+
+    // Classic rounds with early exit. After round k every distance is at most the length of the
+    // best path with k + 1 edges; shortest paths have at most V - 1 edges, so a change in
+    // round V means a negative cycle.
+    static bool bellmanFordRounds(const CSRGraph& g, int* dist, int* parent) {
+        int numVertices = g.getNumVertices();
+        const int* offsets = g.getOffsets();
+        const int* targets = g.getTargets();
+        const int* weights = g.getWeights();
+        for (int round = 0; round < numVertices; round++) {
+            bool changed = false;
+            for (int u = 0; u < numVertices; u++) {
+                int du = dist[u];
+                if (du == INT_MAX) continue;
+                for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                    long long candidate = relaxedDistance(du, weights[i]);
+                    if (candidate < dist[targets[i]]) {
+                        dist[targets[i]] = static_cast<int>(candidate);
+                        parent[targets[i]] = u;
+                        changed = true;
+                    }
+                }
+            }
+            if (!changed) return true;
+        }
+        return false;
+    }
+
+    // SPFA: a FIFO of vertices whose distance dropped (each vertex at most once, so a ring of
+    // V slots suffices). hops[v] counts the edges of v's current path; reaching V edges means
+    // the path repeats a vertex, i.e. runs around a negative cycle.
+    static bool bellmanFordQueue(const CSRGraph& g, int* dist, int* parent) {
+        int numVertices = g.getNumVertices();
+        const int* offsets = g.getOffsets();
+        const int* targets = g.getTargets();
+        const int* weights = g.getWeights();
+        int* ring = new int[numVertices];
+        int* hops = new int[numVertices]();
+        bool* queued = new bool[numVertices]();
+        int head = 0, count = 0;
+        for (int v = 0; v < numVertices; v++) {
+            if (dist[v] != INT_MAX) {
+                ring[count++] = v;
+                queued[v] = true;
+            }
+        }
+
+        bool ok = true;
+        while (count > 0 && ok) {
+            int u = ring[head];
+            head = (head + 1 == numVertices) ? 0 : head + 1;
+            count--;
+            queued[u] = false;
+            int du = dist[u];
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                int v = targets[i];
+                long long candidate = relaxedDistance(du, weights[i]);
+                if (candidate < dist[v]) {
+                    dist[v] = static_cast<int>(candidate);
+                    parent[v] = u;
+                    hops[v] = hops[u] + 1;
+                    if (hops[v] >= numVertices) {
+                        ok = false;
+                        break;
+                    }
+                    if (!queued[v]) {
+                        int tail = head + count;
+                        ring[tail >= numVertices ? tail - numVertices : tail] = v;
+                        count++;
+                        queued[v] = true;
+                    }
+                }
+            }
+        }
+
+        delete[] ring;
+        delete[] hops;
+        delete[] queued;
+        return ok;
+    }
+
+    // Parallel rounds: only the vertices that changed in the previous round are expanded, and
+    // their out-edges are relaxed with a compare-and-swap on the packed (distance, parent) word.
+    // A round still covers at least one classic round, so the same V-round bound applies.
+    static bool bellmanFordParallel(const CSRGraph& g, int* dist, int* parent) {
+        int numVertices = g.getNumVertices();
+        const int* offsets = g.getOffsets();
+        const int* targets = g.getTargets();
+        const int* weights = g.getWeights();
+        std::atomic<uint64_t>* best = new std::atomic<uint64_t>[numVertices];
+        std::atomic<bool>* active = new std::atomic<bool>[numVertices];
+        std::atomic<bool>* nextActive = new std::atomic<bool>[numVertices];
+        for (int v = 0; v < numVertices; v++) {
+            best[v].store(packDistance(dist[v], parent[v]), std::memory_order_relaxed);
+            active[v].store(dist[v] != INT_MAX, std::memory_order_relaxed);
+            nextActive[v].store(false, std::memory_order_relaxed);
+        }
+
+        bool converged = false;
+        for (int round = 0; round < numVertices && !converged; round++) {
+            std::atomic<bool> changed(false);
+            ThreadPool::shared().parallelForEdges(g, 0, [&](int first, int last, int) {
+                for (int u = first; u < last; u++) {
+                    if (!active[u].load(std::memory_order_relaxed)) continue;
+                    active[u].store(false, std::memory_order_relaxed);
+                    int du = unpackDistance(best[u].load(std::memory_order_relaxed));
+                    for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                        int v = targets[i];
+                        long long candidate = relaxedDistance(du, weights[i]);
+                        uint64_t current = best[v].load(std::memory_order_relaxed);
+                        while (candidate < unpackDistance(current)) {
+                            if (best[v].compare_exchange_weak(current, packDistance(static_cast<int>(candidate), u), std::memory_order_relaxed)) {
+                                nextActive[v].store(true, std::memory_order_relaxed);
+                                changed.store(true, std::memory_order_relaxed);
+                                break;
+                            }
+                        }
+                    }
+                }
+            });
+            converged = !changed.load();
+            std::atomic<bool>* swap = active;
+            active = nextActive;
+            nextActive = swap;
+        }
+
+        for (int v = 0; v < numVertices; v++) {
+            uint64_t packed = best[v].load(std::memory_order_relaxed);
+            dist[v] = unpackDistance(packed);
+            parent[v] = unpackParent(packed);
+        }
+        delete[] best;
+        delete[] active;
+        delete[] nextActive;
+        return converged;
+    }
+
+    // Initializes the distances (one source, or every vertex for the virtual source) and
+    // runs the requested variant
+    bool Algorithms::bellmanFordCore(int startVertex, const CSRGraph& g, int* dist, int* parent, BellmanFordVariant variant) {
+        int numVertices = g.getNumVertices();
+        for (int v = 0; v < numVertices; v++) {
+            dist[v] = (startVertex == -1) ? 0 : INT_MAX;
+            parent[v] = -1;
+        }
+        if (startVertex != -1) {
+            dist[startVertex] = 0;
+        }
+        switch (variant) {
+            case ROUNDS: return bellmanFordRounds(g, dist, parent);
+            case PARALLEL_ROUNDS: return bellmanFordParallel(g, dist, parent);
+            default: return bellmanFordQueue(g, dist, parent);
+        }
+    }
+
+    /*
+    * Shortest path tree over a graph that may contain negative weights.
+    * - Builds and returns the tree as a graph (directed if 'g' is directed).
+    *
+    * Throws:
+    * - out_of_range if the start vertex is invalid.
+    * - invalid_argument if a negative cycle is reachable from the start vertex.
+    */
+    Graph Algorithms::bellmanFord(int startVertex, const Graph& g, BellmanFordVariant variant) {
+        int numVertices = g.getNumVertices();
+        if (startVertex < 0 || startVertex >= numVertices) {
+            throw std::out_of_range("Start vertex is out of valid range.");
+        }
+        CSRGraph csr(g);
+        int* dist = new int[numVertices];
+        int* parent = new int[numVertices];
+        if (!bellmanFordCore(startVertex, csr, dist, parent, variant)) {
+            delete[] dist;
+            delete[] parent;
+            throw std::invalid_argument("The graph contains a negative cycle reachable from the start vertex.");
+        }
+
+        Graph shortestPathTree(numVertices, g.isDirected());
+        for (int v = 0; v < numVertices; v++) {
+            if (parent[v] != -1) {
+                int weight = dist[v] - dist[parent[v]];
+                shortestPathTree.addTreeEdge(parent[v], v, weight);
+                if (!g.isDirected()) {
+                    shortestPathTree.addTreeEdge(v, parent[v], weight);
+                }
+            }
+        }
+        delete[] dist;
+        delete[] parent;
+        return shortestPathTree;
+    }
+
+    /*
+    * Shortest distances over a compact graph that may contain negative weights.
+    *
+    * Throws:
+    * - out_of_range if the start vertex is invalid.
+    * - invalid_argument if a negative cycle is reachable from the start vertex.
+    */
+    void Algorithms::bellmanFordDistances(int startVertex, const CSRGraph& g, int* dist, BellmanFordVariant variant) {
+        int numVertices = g.getNumVertices();
+        if (startVertex < 0 || startVertex >= numVertices) {
+            throw std::out_of_range("Start vertex is out of valid range.");
+        }
+        int* parent = new int[numVertices];
+        bool ok = bellmanFordCore(startVertex, g, dist, parent, variant);
+        delete[] parent;
+        if (!ok) {
+            throw std::invalid_argument("The graph contains a negative cycle reachable from the start vertex.");
+        }
+    }
+
+    // A negative cycle anywhere is reachable from a virtual source joined to every vertex
+    bool Algorithms::hasNegativeCycle(const CSRGraph& g) {
+        if (!g.hasNegativeWeights()) {
+            return false;
+        }
+        int numVertices = g.getNumVertices();
+        int* dist = new int[numVertices];
+        int* parent = new int[numVertices];
+        bool ok = bellmanFordCore(-1, g, dist, parent, SPFA);
+        delete[] dist;
+        delete[] parent;
+        return !ok;
+    }
+
+    bool Algorithms::hasNegativeCycle(const Graph& g) {
+        CSRGraph csr(g);
+        return hasNegativeCycle(csr);
+    }
+
+    // Floyd-Warshall for graphs with enough edges per vertex that V^3 simple relaxations beat
+    // V heap-based searches; otherwise repeated Dijkstra, reweighted with Johnson's method
+    // when some weights are negative (one Bellman-Ford pass is cheap next to V Dijkstra runs)
+    Algorithms::AllPairsMethod Algorithms::chooseAllPairsMethod(const CSRGraph& g) {
+        long long n = g.getNumVertices();
+        long long log2n = 1;
+        while ((1LL << log2n) < n) log2n++;
+        long long dijkstraCost = static_cast<long long>(g.getNumEntries()) * log2n * FLOYD_WARSHALL_ADVANTAGE;
+        if (n * n <= dijkstraCost) {
+            return FLOYD_WARSHALL;
+        }
+        return g.hasNegativeWeights() ? JOHNSON : REPEATED_DIJKSTRA;
+    }
+
+    /*
+    * All-pairs shortest paths over a compact graph.
+    *
+    * Johnson's method: Bellman-Ford (SPFA) from a virtual source joined to every vertex gives
+    * potentials h with h[v] <= h[u] + w(u, v) for every edge, so w'(u, v) = w(u, v) + h[u] - h[v]
+    * is never negative. Dijkstra then runs on a view sharing the offsets and targets of 'g' with
+    * the reweighted weights, and d(u, v) = d'(u, v) - h[u] + h[v].
+    *
+    * Throws:
+    * - invalid_argument if REPEATED_DIJKSTRA is requested for a graph with negative weights,
+    *   or if the graph contains a negative cycle (every negative edge of an undirected graph is one).
+    * - overflow_error if a reweighted edge weight does not fit in an int.
+    */
+    DistanceMatrix Algorithms::allPairsShortestPaths(const CSRGraph& g, AllPairsMethod method) {
+        int numVertices = g.getNumVertices();
+        if (method == AUTO) {
+            method = chooseAllPairsMethod(g);
+        }
+        DistanceMatrix result(numVertices);
+
+        // Dijkstra from every source on the shared pool, each thread with its own workspace;
+        // with 'potential' the rows are mapped back from reweighted distances
+        auto repeatedDijkstra = [&result, numVertices](const CSRGraph& graph, const int* potential) {
+            ThreadPool& pool = ThreadPool::shared();
+            PerThread<AlgorithmWorkspace> workspaces(pool);
+            pool.parallelFor(0, numVertices, 0, [&](int first, int last, int thread) {
+                for (int s = first; s < last; s++) {
+                    int* row = result.row(s);
+                    dijkstraRow(s, graph, row, workspaces[thread]);
+                    if (!potential) continue;
+                    for (int v = 0; v < numVertices; v++) {
+                        if (row[v] != INT_MAX) {
+                            row[v] = row[v] - potential[s] + potential[v];
+                        }
+                    }
+                }
+            });
+        };
+
+        if (method == REPEATED_DIJKSTRA) {
+            if (g.hasNegativeWeights()) {
+                throw std::invalid_argument("The graph contains edges with negative weights! Dijkstra's algorithm cannot operate on such a graph.");
+            }
+            repeatedDijkstra(g, nullptr);
+            return result;
+        }
+
+        if (method == JOHNSON) {
+            if (!g.hasNegativeWeights()) {
+                repeatedDijkstra(g, nullptr);  // Nothing to reweight
+                return result;
+            }
+            const int* offsets = g.getOffsets();
+            const int* targets = g.getTargets();
+            const int* weights = g.getWeights();
+            int* potential = new int[numVertices];
+            int* parent = new int[numVertices];
+            bool ok = bellmanFordCore(-1, g, potential, parent, SPFA);
+            delete[] parent;
+            if (!ok) {
+                delete[] potential;
+                throw std::invalid_argument("The graph contains a negative cycle.");
+            }
+
+            int* reweighted = new int[g.getNumEntries() > 0 ? g.getNumEntries() : 1];
+            for (int u = 0; u < numVertices; u++) {
+                for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                    long long w = static_cast<long long>(weights[i]) + potential[u] - potential[targets[i]];
+                    if (w > INT_MAX) {
+                        delete[] potential;
+                        delete[] reweighted;
+                        throw std::overflow_error("Reweighted edge weight does not fit in an int.");
+                    }
+                    reweighted[i] = static_cast<int>(w);
+                }
+            }
+            CSRGraph view(numVertices, g.getNumEntries(), offsets, targets, reweighted, g.isDirected());
+            try {
+                repeatedDijkstra(view, potential);
+            } catch (...) {
+                delete[] potential;
+                delete[] reweighted;
+                throw;
+            }
+            delete[] potential;
+            delete[] reweighted;
+            return result;
+        }
+
+        // Floyd-Warshall starts from the edges; parallel edges keep the lightest weight
+        const int* offsets = g.getOffsets();
+        const int* targets = g.getTargets();
+        const int* weights = g.getWeights();
+        for (int u = 0; u < numVertices; u++) {
+            int* row = result.row(u);
+            row[u] = 0;
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                if (weights[i] < row[targets[i]]) {
+                    row[targets[i]] = weights[i];
+                }
+            }
+        }
+        floydWarshall(result.row(0), numVertices);
+        for (int v = 0; v < numVertices; v++) {
+            if (result.row(v)[v] < 0) {
+                throw std::invalid_argument("The graph contains a negative cycle.");
+            }
+        }
+        return result;
+    }
+
+    // All-pairs shortest paths over a Graph (converted to compact form once)
+    DistanceMatrix Algorithms::allPairsShortestPaths(const Graph& g, AllPairsMethod method) {
+        CSRGraph csr(g);
+        return allPairsShortestPaths(csr, method);
+    }
+
+}
@@ -0,0 +1,348 @@
+// shirat345@gmail.com
+#include "Simd.h"
+#include <atomic>
+#include <climits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EX1_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace graph {
+
+    // ---------------- Scalar versions ----------------
+
+    static bool anyNegativeScalar(const int* values, int count) {
+        for (int i = 0; i < count; i++) {
+            if (values[i] < 0) return true;
+        }
+        return false;
+    }
+
+    static int minIndexScalar(const int* values, int count) {
+        int best = count > 0 ? 0 : -1;
+        for (int i = 1; i < count; i++) {
+            if (values[i] < values[best]) best = i;
+        }
+        return best;
+    }
+
+    static long long frontierUpdateScalar(uint64_t* next, uint64_t* visited, int words) {
+        long long count = 0;
+        for (int i = 0; i < words; i++) {
+            uint64_t fresh = next[i] & ~visited[i];
+            next[i] = fresh;
+            visited[i] |= fresh;
+            count += __builtin_popcountll(fresh);
+        }
+        return count;
+    }
+
+    // Sums are taken in 64 bits and saturated: above INT_MAX they can never improve the row,
+    // below INT_MIN they are clamped to INT_MIN (so a negative cycle stays visible)
+    static void minPlusRowScalar(int* row, const int* through, int offset, int count) {
+        for (int j = 0; j < count; j++) {
+            if (through[j] == INT_MAX) continue;
+            long long sum = static_cast<long long>(offset) + through[j];
+            if (sum < INT_MIN) sum = INT_MIN;
+            if (sum < row[j]) {
+                row[j] = static_cast<int>(sum);
+            }
+        }
+    }
+
+#ifdef EX1_SIMD_X86
+
+    // ---------------- AVX2 versions ----------------
+
+    __attribute__((target("avx2")))
+    static bool anyNegativeAvx2(const int* values, int count) {
+        int i = 0;
+        // OR blocks of 32 values together: the sign bit survives if any value is negative
+        for (; i + 32 <= count; i += 32) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 8));
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 16));
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 24));
+            __m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+            if (_mm256_movemask_ps(_mm256_castsi256_ps(any))) return true;
+        }
+        for (; i + 8 <= count; i += 8) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            if (_mm256_movemask_ps(_mm256_castsi256_ps(a))) return true;
+        }
+        return anyNegativeScalar(values + i, count - i);
+    }
+
+    __attribute__((target("avx2")))
+    static int minIndexAvx2(const int* values, int count) {
+        if (count < 16) return minIndexScalar(values, count);
+
+        // Pass 1: the minimum value
+        __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+        int i = 8;
+        for (; i + 8 <= count; i += 8) {
+            best = _mm256_min_epi32(best, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+        }
+        int lanes[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), best);
+        int minimum = lanes[0];
+        for (int k = 1; k < 8; k++) {
+            if (lanes[k] < minimum) minimum = lanes[k];
+        }
+        for (; i < count; i++) {
+            if (values[i] < minimum) minimum = values[i];
+        }
+
+        // Pass 2: its first position
+        __m256i target = _mm256_set1_epi32(minimum);
+        for (i = 0; i + 8 <= count; i += 8) {
+            __m256i eq = _mm256_cmpeq_epi32(target, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+            int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+            if (mask) return i + __builtin_ctz(mask);
+        }
+        for (; i < count; i++) {
+            if (values[i] == minimum) return i;
+        }
+        return -1;
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    static long long frontierUpdateAvx2(uint64_t* next, uint64_t* visited, int words) {
+        long long count = 0;
+        int i = 0;
+        for (; i + 4 <= words; i += 4) {
+            __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(next + i));
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(visited + i));
+            __m256i fresh = _mm256_andnot_si256(v, n);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(next + i), fresh);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(visited + i), _mm256_or_si256(v, fresh));
+            if (!_mm256_testz_si256(fresh, fresh)) {
+                count += _mm_popcnt_u64(next[i]) + _mm_popcnt_u64(next[i + 1])
+                       + _mm_popcnt_u64(next[i + 2]) + _mm_popcnt_u64(next[i + 3]);
+            }
+        }
+        return count + frontierUpdateScalar(next + i, visited + i, words - i);
+    }
+
+    __attribute__((target("avx2")))
+    static void minPlusRowAvx2(int* row, const int* through, int offset, int count) {
+        __m256i unreachable = _mm256_set1_epi32(INT_MAX);
+        __m256i add = _mm256_set1_epi32(offset);
+        // Value of an overflowing sum: all its lanes overflow in the direction of 'offset'
+        __m256i saturated = _mm256_set1_epi32(offset < 0 ? INT_MIN : INT_MAX);
+        int j = 0;
+        for (; j + 8 <= count; j += 8) {
+            __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(through + j));
+            __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + j));
+            // The wrapped sum overflowed iff its sign differs from the sign of both operands
+            __m256i sum = _mm256_add_epi32(t, add);
+            __m256i overflow = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(t, sum), _mm256_xor_si256(add, sum)), 31);
+            sum = _mm256_blendv_epi8(sum, saturated, overflow);
+            __m256i better = _mm256_min_epi32(r, sum);
+            // Lanes where 'through' is unreachable keep their old value
+            __m256i result = _mm256_blendv_epi8(better, r, _mm256_cmpeq_epi32(t, unreachable));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + j), result);
+        }
+        minPlusRowScalar(row + j, through + j, offset, count - j);
+    }
+
+    // ---------------- AVX-512 versions ----------------
+
+    __attribute__((target("avx512f")))
+    static bool anyNegativeAvx512(const int* values, int count) {
+        __m512i zero = _mm512_setzero_si512();
+        int i = 0;
+        for (; i + 32 <= count; i += 32) {
+            __m512i a = _mm512_loadu_si512(values + i);
+            __m512i b = _mm512_loadu_si512(values + i + 16);
+            if (_mm512_cmplt_epi32_mask(_mm512_or_si512(a, b), zero)) return true;
+        }
+        for (; i + 16 <= count; i += 16) {
+            if (_mm512_cmplt_epi32_mask(_mm512_loadu_si512(values + i), zero)) return true;
+        }
+        if (i < count) {
+            __mmask16 tail = static_cast<__mmask16>((1u << (count - i)) - 1);
+            __m512i rest = _mm512_maskz_loadu_epi32(tail, values + i);
+            if (_mm512_mask_cmplt_epi32_mask(tail, rest, zero)) return true;
+        }
+        return false;
+    }
+
+    __attribute__((target("avx512f")))
+    static int minIndexAvx512(const int* values, int count) {
+        if (count < 32) return minIndexScalar(values, count);
+
+        // Pass 1: the minimum value. In GCC 12's avx512fintrin.h, _mm512_min_epi32,
+        // _mm512_reduce_min_epi32 and the 512 -> 256 bit extracts / casts pass an undefined vector
+        // through, which trips -Wmaybe-uninitialized in optimized builds; the masked forms with a
+        // full mask and a defined source compute the same thing without it.
+        const __mmask16 all = 0xFFFF;
+        __m512i best = _mm512_loadu_si512(values);
+        int i = 16;
+        for (; i + 16 <= count; i += 16) {
+            best = _mm512_mask_min_epi32(best, all, best, _mm512_loadu_si512(values + i));
+        }
+        __m256i low = _mm512_mask_extracti64x4_epi64(_mm256_setzero_si256(), 0xF, best, 0);
+        __m256i high = _mm512_mask_extracti64x4_epi64(_mm256_setzero_si256(), 0xF, best, 1);
+        __m256i half = _mm256_min_epi32(low, high);
+        int lanes[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), half);
+        int minimum = lanes[0];
+        for (int k = 1; k < 8; k++) {
+            if (lanes[k] < minimum) minimum = lanes[k];
+        }
+        for (; i < count; i++) {
+            if (values[i] < minimum) minimum = values[i];
+        }
+
+        // Pass 2: its first position
+        __m512i target = _mm512_set1_epi32(minimum);
+        for (i = 0; i + 16 <= count; i += 16) {
+            __mmask16 eq = _mm512_cmpeq_epi32_mask(target, _mm512_loadu_si512(values + i));
+            if (eq) return i + __builtin_ctz(eq);
+        }
+        for (; i < count; i++) {
+            if (values[i] == minimum) return i;
+        }
+        return -1;
+    }
+
+    __attribute__((target("avx512f,popcnt")))
+    static long long frontierUpdateAvx512(uint64_t* next, uint64_t* visited, int words) {
+        long long count = 0;
+        int i = 0;
+        for (; i + 8 <= words; i += 8) {
+            __m512i n = _mm512_loadu_si512(next + i);
+            __m512i v = _mm512_loadu_si512(visited + i);
+            // Masked form with a zero source: _mm512_andnot_si512 trips the same GCC 12 warning
+            __m512i fresh = _mm512_mask_andnot_epi64(_mm512_setzero_si512(), 0xFF, v, n);
+            _mm512_storeu_si512(next + i, fresh);
+            _mm512_storeu_si512(visited + i, _mm512_or_si512(v, fresh));
+            if (_mm512_test_epi64_mask(fresh, fresh)) {
+                for (int k = 0; k < 8; k++) {
+                    count += _mm_popcnt_u64(next[i + k]);
+                }
+            }
+        }
+        return count + frontierUpdateScalar(next + i, visited + i, words - i);
+    }
+
+    // t + add with overflowing lanes replaced by 'saturated' (INT_MAX or INT_MIN, by the sign of 'add'):
+    // the wrapped sum overflowed iff its sign differs from the sign of both operands
+    __attribute__((target("avx512f")))
+    static inline __m512i saturatingAddAvx512(__m512i t, __m512i add, __m512i saturated, __m512i zero) {
+        __m512i sum = _mm512_add_epi32(t, add);
+        __m512i signs = _mm512_and_epi32(_mm512_xor_epi32(t, sum), _mm512_xor_epi32(add, sum));
+        return _mm512_mask_blend_epi32(_mm512_cmplt_epi32_mask(signs, zero), sum, saturated);
+    }
+
+    __attribute__((target("avx512f")))
+    static void minPlusRowAvx512(int* row, const int* through, int offset, int count) {
+        __m512i unreachable = _mm512_set1_epi32(INT_MAX);
+        __m512i add = _mm512_set1_epi32(offset);
+        __m512i saturated = _mm512_set1_epi32(offset < 0 ? INT_MIN : INT_MAX);
+        __m512i zero = _mm512_setzero_si512();
+        int j = 0;
+        for (; j + 16 <= count; j += 16) {
+            __m512i t = _mm512_loadu_si512(through + j);
+            __m512i r = _mm512_loadu_si512(row + j);
+            __mmask16 reachable = _mm512_cmpneq_epi32_mask(t, unreachable);
+            _mm512_storeu_si512(row + j, _mm512_mask_min_epi32(r, reachable, r, saturatingAddAvx512(t, add, saturated, zero)));
+        }
+        if (j < count) {
+            __mmask16 tail = static_cast<__mmask16>((1u << (count - j)) - 1);
+            __m512i t = _mm512_maskz_loadu_epi32(tail, through + j);
+            __m512i r = _mm512_maskz_loadu_epi32(tail, row + j);
+            __mmask16 reachable = _mm512_mask_cmpneq_epi32_mask(tail, t, unreachable);
+            _mm512_mask_storeu_epi32(row + j, tail, _mm512_mask_min_epi32(r, reachable, r, saturatingAddAvx512(t, add, saturated, zero)));
+        }
+    }
+
+#endif
+
+    // ---------------- Dispatch ----------------
+
+    struct Kernels {
+        Simd::Level level;
+        bool (*anyNegative)(const int*, int);
+        int (*minIndex)(const int*, int);
+        long long (*frontierUpdate)(uint64_t*, uint64_t*, int);
+        void (*minPlusRow)(int*, const int*, int, int);
+    };
+
+    static const Kernels scalarKernels = {Simd::SCALAR, anyNegativeScalar, minIndexScalar, frontierUpdateScalar, minPlusRowScalar};
+#ifdef EX1_SIMD_X86
+    static const Kernels avx2Kernels = {Simd::AVX2, anyNegativeAvx2, minIndexAvx2, frontierUpdateAvx2, minPlusRowAvx2};
+    static const Kernels avx512Kernels = {Simd::AVX512, anyNegativeAvx512, minIndexAvx512, frontierUpdateAvx512, minPlusRowAvx512};
+#endif
+
+    static std::atomic<const Kernels*> activeKernels(nullptr);
+
+    // Kernels for a level (which must be supported)
+    static const Kernels* kernelsFor(Simd::Level level) {
+#ifdef EX1_SIMD_X86
+        if (level == Simd::AVX512) return &avx512Kernels;
+        if (level == Simd::AVX2) return &avx2Kernels;
+#endif
+        (void)level;
+        return &scalarKernels;
+    }
+
+    // Selected kernels, chosen on first use
+    static const Kernels* kernels() {
+        const Kernels* k = activeKernels.load(std::memory_order_acquire);
+        if (!k) {
+            k = kernelsFor(Simd::supportedLevel());
+            activeKernels.store(k, std::memory_order_release);
+        }
+        return k;
+    }
+
+    // Best level of this CPU
+    Simd::Level Simd::supportedLevel() {
+#ifdef EX1_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("popcnt")) return AVX512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) return AVX2;
+#endif
+        return SCALAR;
+    }
+
+    // Level in use
+    Simd::Level Simd::getLevel() {
+        return kernels()->level;
+    }
+
+    // Forces a level, lowered to what the CPU supports
+    void Simd::setLevel(Level level) {
+        Level supported = supportedLevel();
+        activeKernels.store(kernelsFor(level < supported ? level : supported), std::memory_order_release);
+    }
+
+    // Printable level name
+    const char* Simd::name(Level level) {
+        switch (level) {
+            case AVX512: return "AVX-512";
+            case AVX2: return "AVX2";
+            default: return "scalar";
+        }
+    }
+
+    bool Simd::anyNegative(const int* values, int count) {
+        return kernels()->anyNegative(values, count);
+    }
+
+    int Simd::minIndex(const int* values, int count) {
+        return kernels()->minIndex(values, count);
+    }
+
+    long long Simd::frontierUpdate(uint64_t* next, uint64_t* visited, int words) {
+        return kernels()->frontierUpdate(next, visited, words);
+    }
+
+    void Simd::minPlusRow(int* row, const int* through, int offset, int count) {
+        kernels()->minPlusRow(row, through, offset, count);
+    }
+
+}
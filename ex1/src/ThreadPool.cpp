@@ -0,0 +1,288 @@
+// shirat345@gmail.com
+#include "ThreadPool.h"
+#include <cstdlib>
+#include <memory>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace graph {
+
+    // The pool whose loop the calling thread is running, and its index in that loop
+    static thread_local const ThreadPool* activePool = nullptr;
+    static thread_local int activeThread = 0;
+
+    static std::mutex sharedLock;
+    static std::unique_ptr<ThreadPool> sharedPool;
+
+    // Binds the calling thread to one core (no-op where affinity is not supported)
+    static void pinToCore(int thread) {
+#ifdef __linux__
+        int cores = static_cast<int>(std::thread::hardware_concurrency());
+        if (cores <= 0) return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(thread % cores, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)thread;
+#endif
+    }
+
+    // Constructor: starts numThreads - 1 workers, the caller of parallelFor is thread 0
+    ThreadPool::ThreadPool(int threads, bool pinThreads)
+        : numThreads(threads), workers(nullptr), blocks(nullptr), jobId(0), stopping(false), busyWorkers(0),
+          body(nullptr), jobBegin(0), jobEnd(0), jobGrain(1), failed(false) {
+        if (numThreads <= 0) {
+            numThreads = static_cast<int>(std::thread::hardware_concurrency());
+            if (numThreads <= 0) numThreads = 1;
+        }
+        blocks = new Block[numThreads];
+        for (int t = 0; t < numThreads; t++) {
+            blocks[t].front = blocks[t].back = 0;
+        }
+        workers = new std::thread[numThreads - 1];
+        for (int t = 1; t < numThreads; t++) {
+            workers[t - 1] = std::thread(&ThreadPool::workerLoop, this, t, pinThreads);
+        }
+    }
+
+    // Destructor: wakes the workers with the stop flag and joins them
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (int t = 0; t < numThreads - 1; t++) {
+            workers[t].join();
+        }
+        delete[] workers;
+        delete[] blocks;
+    }
+
+    // workerLoop: waits for a job, helps with it, reports that it left, repeats.
+    // Every worker takes part in every job exactly once: the next job only starts
+    // after busyWorkers dropped to 0.
+    void ThreadPool::workerLoop(int thread, bool pin) {
+        if (pin) {
+            pinToCore(thread);
+        }
+        activePool = this;
+        activeThread = thread;
+        unsigned long long seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [this, seen]() { return stopping || jobId != seen; });
+                if (stopping) return;
+                seen = jobId;
+            }
+            runChunks(thread);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (--busyWorkers == 0) {
+                    done.notify_one();
+                }
+            }
+        }
+    }
+
+    // runChunks: runs chunks of the own block, then steals until no block has any left.
+    // After a failure the remaining chunks are drained without running them.
+    void ThreadPool::runChunks(int thread) {
+        int chunk;
+        do {
+            while (takeChunk(thread, chunk)) {
+                if (failed.load(std::memory_order_relaxed)) continue;
+                long long b = static_cast<long long>(jobBegin) + static_cast<long long>(chunk) * jobGrain;
+                long long e = b + jobGrain < jobEnd ? b + jobGrain : jobEnd;
+                try {
+                    (*body)(static_cast<int>(b), static_cast<int>(e), thread);
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (!error) error = std::current_exception();
+                    failed.store(true);
+                }
+            }
+        } while (steal(thread));
+    }
+
+    // takeChunk: pops the next chunk from the front of the thread's own block
+    bool ThreadPool::takeChunk(int thread, int& chunk) {
+        Block& own = blocks[thread];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (own.front >= own.back) return false;
+        chunk = own.front++;
+        return true;
+    }
+
+    // steal: moves the upper half of the fullest other block into the (empty) own block.
+    // Returns false when every block is empty.
+    bool ThreadPool::steal(int thread) {
+        while (true) {
+            int victim = -1;
+            int most = 0;
+            for (int t = 0; t < numThreads; t++) {
+                if (t == thread) continue;
+                std::lock_guard<std::mutex> guard(blocks[t].lock);
+                int remaining = blocks[t].back - blocks[t].front;
+                if (remaining > most) {
+                    most = remaining;
+                    victim = t;
+                }
+            }
+            if (victim < 0) return false;
+
+            int from, to;
+            {
+                std::lock_guard<std::mutex> guard(blocks[victim].lock);
+                Block& v = blocks[victim];
+                if (v.front >= v.back) continue;  // Emptied meanwhile, look again
+                from = v.front + (v.back - v.front) / 2;
+                to = v.back;
+                v.back = from;
+            }
+            std::lock_guard<std::mutex> guard(blocks[thread].lock);
+            blocks[thread].front = from;
+            blocks[thread].back = to;
+            return true;
+        }
+    }
+
+    int ThreadPool::getNumThreads() const {
+        return numThreads;
+    }
+
+    // parallelFor: splits the range into chunks, gives each thread a contiguous block of them,
+    // wakes the workers and works along until all of them left the job
+    void ThreadPool::parallelFor(int begin, int end, int grain, const RangeBody& rangeBody) {
+        if (end <= begin) return;
+        int length = end - begin;
+        if (grain <= 0) {
+            grain = length / (numThreads * 8);
+            if (grain < 1) grain = 1;
+        }
+        int numChunks = length / grain + (length % grain != 0);
+
+        // Nested calls, single-threaded pools and single chunks run right here
+        if (activePool == this || numThreads == 1 || numChunks == 1) {
+            const ThreadPool* previousPool = activePool;
+            int previousThread = activeThread;
+            int thread = (activePool == this) ? activeThread : 0;
+            activePool = this;
+            activeThread = thread;
+            try {
+                for (long long b = begin; b < end; b += grain) {
+                    long long e = b + grain < end ? b + grain : end;
+                    rangeBody(static_cast<int>(b), static_cast<int>(e), thread);
+                }
+            } catch (...) {
+                activePool = previousPool;
+                activeThread = previousThread;
+                throw;
+            }
+            activePool = previousPool;
+            activeThread = previousThread;
+            return;
+        }
+
+        std::lock_guard<std::mutex> serial(jobLock);
+        for (int t = 0; t < numThreads; t++) {
+            std::lock_guard<std::mutex> guard(blocks[t].lock);
+            blocks[t].front = static_cast<int>(static_cast<long long>(numChunks) * t / numThreads);
+            blocks[t].back = static_cast<int>(static_cast<long long>(numChunks) * (t + 1) / numThreads);
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            body = &rangeBody;
+            jobBegin = begin;
+            jobEnd = end;
+            jobGrain = grain;
+            failed.store(false);
+            error = nullptr;
+            busyWorkers = numThreads - 1;
+            jobId++;
+        }
+        wake.notify_all();
+
+        const ThreadPool* previousPool = activePool;
+        int previousThread = activeThread;
+        activePool = this;
+        activeThread = 0;
+        runChunks(0);
+        activePool = previousPool;
+        activeThread = previousThread;
+
+        std::exception_ptr failure;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            done.wait(guard, [this]() { return busyWorkers == 0; });
+            failure = error;
+            error = nullptr;
+            body = nullptr;
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    // parallelForEdges: cuts the vertices into ranges of about 'edgesPerChunk' entries using
+    // the CSR offsets, then runs a parallelFor over those ranges
+    void ThreadPool::parallelForEdges(const CSRGraph& g, int edgesPerChunk, const RangeBody& rangeBody) {
+        int n = g.getNumVertices();
+        if (n == 0) return;
+        const int* offsets = g.getOffsets();
+        if (edgesPerChunk <= 0) {
+            edgesPerChunk = g.getNumEntries() / (numThreads * 8);
+            if (edgesPerChunk < 1) edgesPerChunk = 1;
+        }
+
+        // Start vertex of every range; a range ends once it holds edgesPerChunk entries
+        int numRanges = 0;
+        int* starts = new int[n + 1];
+        int v = 0;
+        while (v < n) {
+            starts[numRanges++] = v;
+            int limit = offsets[v] + edgesPerChunk;
+            v++;
+            while (v < n && offsets[v + 1] <= limit) v++;
+        }
+        starts[numRanges] = n;
+
+        try {
+            parallelFor(0, numRanges, 1, [starts, &rangeBody](int first, int last, int thread) {
+                for (int r = first; r < last; r++) {
+                    rangeBody(starts[r], starts[r + 1], thread);
+                }
+            });
+        } catch (...) {
+            delete[] starts;
+            throw;
+        }
+        delete[] starts;
+    }
+
+    // shared: creates the process-wide pool on first use
+    ThreadPool& ThreadPool::shared() {
+        std::lock_guard<std::mutex> guard(sharedLock);
+        if (!sharedPool) {
+            const char* setting = std::getenv("EX1_THREADS");
+            int threads = setting ? std::atoi(setting) : 0;
+            sharedPool.reset(new ThreadPool(threads));
+        }
+        return *sharedPool;
+    }
+
+    // configureShared: replaces the process-wide pool
+    void ThreadPool::configureShared(int numThreads, bool pinThreads) {
+        std::lock_guard<std::mutex> guard(sharedLock);
+        sharedPool.reset(new ThreadPool(numThreads, pinThreads));
+    }
+
+    int ThreadPool::currentThread() {
+        return activeThread;
+    }
+
+}
@@ -0,0 +1,115 @@
+// shirat345@gmail.com
+#include "Tracer.h"
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace graph {
+
+    static std::atomic<Tracer*> installedTracer(nullptr);
+
+    // Origin of all trace timestamps, fixed at the first use
+    static std::chrono::steady_clock::time_point traceOrigin() {
+        static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+        return origin;
+    }
+
+    // Small sequential id of the calling thread (Chrome traces want integer thread ids)
+    static int threadNumber() {
+        static std::atomic<int> nextThread(1);
+        static thread_local int number = nextThread.fetch_add(1);
+        return number;
+    }
+
+    // Installs the global tracer
+    void Tracer::setTracer(Tracer* tracer) {
+        traceOrigin();
+        installedTracer.store(tracer, std::memory_order_release);
+    }
+
+    // Returns the global tracer, or nullptr
+    Tracer* Tracer::getTracer() {
+        return installedTracer.load(std::memory_order_acquire);
+    }
+
+    // Nanoseconds since the trace origin
+    long long Tracer::now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - traceOrigin()).count();
+    }
+
+    // Starts the first phase (only reads the clock if a tracer is installed)
+    PhaseTrace::PhaseTrace(const char* algorithm, const char* firstPhase)
+        : tracer(Tracer::getTracer()), algorithm(algorithm), phase(firstPhase), start(0) {
+        if (tracer) start = Tracer::now();
+    }
+
+    // Ends the last phase
+    PhaseTrace::~PhaseTrace() {
+        if (tracer) {
+            tracer->onPhase(algorithm, phase, start, Tracer::now() - start);
+        }
+    }
+
+    // Ends the current phase and starts the next one
+    void PhaseTrace::next(const char* nextPhase) {
+        if (tracer) {
+            long long end = Tracer::now();
+            tracer->onPhase(algorithm, phase, start, end - start);
+            start = end;
+        }
+        phase = nextPhase;
+    }
+
+    // Records one phase
+    void ChromeTraceExporter::onPhase(const char* algorithm, const char* phase, long long startNs, long long durationNs) {
+        Event event = {algorithm, phase, startNs, durationNs, threadNumber()};
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back(event);
+    }
+
+    // Number of recorded phases
+    size_t ChromeTraceExporter::getNumEvents() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return events.size();
+    }
+
+    // Drops the recorded phases
+    void ChromeTraceExporter::clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.clear();
+    }
+
+    // Writes the trace event JSON
+    void ChromeTraceExporter::write(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ios::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::fixed << std::setprecision(3);
+        out << "{\"traceEvents\": [";
+        for (size_t i = 0; i < events.size(); i++) {
+            const Event& e = events[i];
+            out << (i ? ",\n" : "\n")
+                << "  {\"name\": \"" << e.phase << "\", \"cat\": \"" << e.algorithm
+                << "\", \"ph\": \"X\", \"ts\": " << e.startNs / 1000.0
+                << ", \"dur\": " << e.durationNs / 1000.0
+                << ", \"pid\": 1, \"tid\": " << e.thread << "}";
+        }
+        out << "\n], \"displayTimeUnit\": \"ns\"}\n";
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    // Writes the trace to a file
+    void ChromeTraceExporter::save(const std::string& path) const {
+        std::ofstream out(path.c_str());
+        if (!out) {
+            throw std::runtime_error("Cannot open trace file: " + path);
+        }
+        write(out);
+        if (!out) {
+            throw std::runtime_error("Cannot write trace file: " + path);
+        }
+    }
+
+}
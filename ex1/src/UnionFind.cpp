@@ -1,12 +1,16 @@
 // shirat345@gmail.com
 #include "UnionFind.h"
+#include "AllocationTracker.h"
+#include "AlgorithmStats.h"
 #include <climits>
 
 // Constructor: initializes the UnionFind structure with 'n' elements.
 // Each element is initially in its own set (parent points to itself).
 // The rank array is used for optimizing union operations.
 UnionFind::UnionFind(int n) {
+    EX1_ALLOC_SCOPE(UNION_FIND);
     size = n;
+    sets = n;               // Every element starts in its own set
     parent = new int[size];  // Array to store the parent of each element
     rank = new int[size];    // Array to store the rank (tree height) of each set
 
@@ -27,8 +31,15 @@ UnionFind::~UnionFind() {
 // This method finds the root of the set containing 'x' and applies path compression
 // to flatten the structure, speeding up future find operations.
 int UnionFind::find(int x) {
+    EX1_STATS_ADD(findCalls, 1);
+    return findRoot(x);
+}
+
+// Recursive part of find, counting every parent link followed.
+int UnionFind::findRoot(int x) {
     if (parent[x] != x) {
-        parent[x] = find(parent[x]);  // Path compression: recursively find the root
+        EX1_STATS_ADD(findSteps, 1);
+        parent[x] = findRoot(parent[x]);  // Path compression: recursively find the root
     }
     return parent[x];
 }
@@ -36,12 +47,13 @@ int UnionFind::find(int x) {
 // Union operation to combine the sets containing 'x' and 'y'.
 // The set with the higher rank becomes the parent of the set with the lower rank,
 // ensuring that the tree remains shallow for efficiency.
-void UnionFind::unionSets(int x, int y) {
+bool UnionFind::unionSets(int x, int y) {
     int rootX = find(x);  // Find the root of the set containing 'x'
     int rootY = find(y);  // Find the root of the set containing 'y'
 
     // If they are already in the same set, no union is needed
-    if (rootX == rootY) return;
+    if (rootX == rootY) return false;
+    sets--;  // Two sets become one
 
     // Union by rank: attach the tree with the smaller rank under the tree with the larger rank
     if (rank[rootX] > rank[rootY]) {
@@ -52,4 +64,15 @@ void UnionFind::unionSets(int x, int y) {
         parent[rootY] = rootX;  // Arbitrary decision when both ranks are equal
         rank[rootX]++;  // Increment the rank of the new root
     }
+    return true;
+}
+
+// Checks whether 'x' and 'y' have the same root.
+bool UnionFind::connected(int x, int y) {
+    return find(x) == find(y);
+}
+
+// Returns the number of disjoint sets.
+int UnionFind::getNumSets() const {
+    return sets;
 }
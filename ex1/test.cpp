@@ -3,6 +3,35 @@
 #include "doctest.h"
 #include "Graph.h"
 #include "Algorithms.h"
+#include "CSRGraph.h"
+#include "GraphFile.h"
+#include "GraphBuilder.h"
+#include "EdgeListLoader.h"
+#include <fstream>
+#include <sstream>
+#include "GraphWriter.h"
+#include "DeltaGraph.h"
+#include "DynamicMST.h"
+#include "Reordering.h"
+#include "AlgorithmWorkspace.h"
+#include "Generators.h"
+#include "Tracer.h"
+#include "AllocationTracker.h"
+#include "UnionFind.h"
+#include "Simd.h"
+#include "EdgeBuffer.h"
+#include "ThreadPool.h"
+#include "GraphSnapshot.h"
+#include "DistanceMatrix.h"
+#include "IndexedHeap.h"
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <climits>
+#include <vector>
+#include <atomic>
+#include <algorithm>
 using namespace graph;
 
 TEST_CASE("AddEdge - Adds edge correctly") {
@@ -197,3 +226,1485 @@ TEST_CASE("Algorithms - Kruskal") {
     Graph mst = Algorithms::kruskal(g);
     CHECK(mst.getNumVertices() == g.getNumVertices());
 }
+
+TEST_CASE("CSRGraph - matches adjacency lists") {
+    Graph g(4);
+    g.addEdge(0, 1, 5);
+    g.addEdge(0, 2, -1);
+    g.addEdge(2, 3, 7);
+    CSRGraph csr(g);
+    CHECK(csr.getNumVertices() == 4);
+    CHECK(csr.getNumEntries() == 6);
+    CHECK(csr.degree(0) == 2);
+    CHECK(csr.degree(3) == 1);
+    CHECK(csr.getTargets()[csr.getOffsets()[3]] == 2);
+    CHECK(csr.hasNegativeWeights() == true);
+}
+
+TEST_CASE("GraphFile - write and map round trip") {
+    const char* path = "graph_file_test.bin";
+    Graph g(5);
+    g.addEdge(0, 1, 4);
+    g.addEdge(0, 2, 1);
+    g.addEdge(1, 2, 2);
+    g.addEdge(3, 4, 5);
+    GraphFile::write(g, path);
+    {
+        MappedGraph mapped(path);
+        const CSRGraph& csr = mapped.getGraph();
+        CHECK(csr.getNumVertices() == 5);
+        CHECK(csr.getNumEntries() == 8);
+
+        Graph reloaded = mapped.toGraph();
+        NeighborVer* a = g.getAdjList()[0].neighbors;
+        NeighborVer* b = reloaded.getAdjList()[0].neighbors;
+        while (a && b) {
+            CHECK(a->vertex == b->vertex);
+            CHECK(a->weight == b->weight);
+            a = a->next;
+            b = b->next;
+        }
+        CHECK(a == nullptr);
+        CHECK(b == nullptr);
+
+        Graph mst = Algorithms::prim(csr);
+        CHECK(mst.getAdjList()[4].neighbors->vertex == 3);  // Spanning forest: {3, 4} is its own tree
+        Graph spt = Algorithms::dijkstra(0, csr);
+        CHECK(spt.getAdjList()[1].neighbors->vertex == 2);  // 0 -> 2 -> 1 is shorter than 0 -> 1
+    }
+    std::remove(path);
+    CHECK_THROWS_AS(MappedGraph("graph_file_missing.bin"), std::runtime_error);
+}
+
+TEST_CASE("Algorithms - CSR traversals match Graph traversals") {
+    Graph g(6);
+    g.addEdge(0, 1);
+    g.addEdge(0, 2);
+    g.addEdge(1, 3);
+    g.addEdge(2, 3);
+    g.addEdge(4, 5);
+    CSRGraph csr(g);
+
+    Graph a = Algorithms::dfs(0, g);
+    Graph b = Algorithms::dfs(0, csr);
+    Graph c = Algorithms::bfs(0, g);
+    Graph d = Algorithms::bfs(0, csr);
+    for (int v = 0; v < 6; v++) {
+        NeighborVer* x = a.getAdjList()[v].neighbors;
+        NeighborVer* y = b.getAdjList()[v].neighbors;
+        for (; x && y; x = x->next, y = y->next) {
+            CHECK(x->vertex == y->vertex);
+        }
+        CHECK(x == y);
+        x = c.getAdjList()[v].neighbors;
+        y = d.getAdjList()[v].neighbors;
+        for (; x && y; x = x->next, y = y->next) {
+            CHECK(x->vertex == y->vertex);
+        }
+        CHECK(x == y);
+    }
+}
+
+TEST_CASE("GraphBuilder - same lists as repeated addEdge") {
+    int edges[][3] = {{0, 1, 4}, {2, 0, 1}, {1, 2, 2}, {0, 1, 9}, {3, 1, 6}};
+    Graph expected(4);
+    GraphBuilder builder;
+    for (int i = 0; i < 5; i++) {
+        expected.addEdge(edges[i][0], edges[i][1], edges[i][2]);
+        builder.addEdge(edges[i][0], edges[i][1], edges[i][2]);
+    }
+    Graph built = builder.buildGraph();
+    CHECK(built.getNumVertices() == 4);
+    for (int v = 0; v < 4; v++) {
+        NeighborVer* a = expected.getAdjList()[v].neighbors;
+        NeighborVer* b = built.getAdjList()[v].neighbors;
+        for (; a && b; a = a->next, b = b->next) {
+            CHECK(a->vertex == b->vertex);
+            CHECK(a->weight == b->weight);
+        }
+        CHECK(a == b);
+    }
+    CHECK_THROWS_AS(builder.addEdge(2, 2), std::invalid_argument);
+    CHECK_THROWS_AS(builder.addEdge(-1, 2), std::out_of_range);
+    CHECK_THROWS_AS(builder.build(3), std::out_of_range);
+}
+
+TEST_CASE("EdgeListLoader - parses files in parallel") {
+    const char* path = "edge_list_test.txt";
+    {
+        std::ofstream out(path);
+        out << "# comment\n0 1 4\n0\t2 1\r\n\n1 2\n% another comment\n3 4 -5\n";
+        for (int i = 5; i < 200; i++) {
+            out << i << " " << i - 1 << " " << i << "\n";
+        }
+    }
+    CSRGraph one = EdgeListLoader::loadCSR(path, 0, 1);
+    CSRGraph four = EdgeListLoader::loadCSR(path, 0, 4);
+    CHECK(one.getNumVertices() == 200);
+    CHECK(one.getNumEntries() == 2 * 199);
+    CHECK(four.getNumEntries() == one.getNumEntries());
+    for (int i = 0; i < one.getNumEntries(); i++) {
+        CHECK(one.getTargets()[i] == four.getTargets()[i]);
+        CHECK(one.getWeights()[i] == four.getWeights()[i]);
+    }
+    CHECK(one.hasNegativeWeights() == true);
+    std::remove(path);
+
+    GraphBuilder builder;
+    const char bad[] = "0 1 x\n";
+    CHECK_THROWS_AS(EdgeListLoader::parse(bad, sizeof(bad) - 1, builder), std::runtime_error);
+    CHECK_THROWS_AS(EdgeListLoader::loadCSR("edge_list_missing.txt"), std::runtime_error);
+}
+
+TEST_CASE("GraphWriter - formats") {
+    Graph g(3);
+    g.addEdge(0, 1, 4);
+    g.addEdge(1, 2, -2);
+
+    std::ostringstream adjacency, edges, dot, json;
+    {
+        GraphWriter w(adjacency, 64);  // Small buffer to exercise intermediate flushes
+        w.write(g, GraphWriter::ADJACENCY);
+    }
+    CHECK(adjacency.str() == "vertex: (neighbor, [Edge weight])\n0: (1, [4])\n1: (2, [-2]) - (0, [4])\n2: (1, [-2])\n");
+    {
+        GraphWriter w(edges);
+        w.write(g, GraphWriter::EDGE_LIST);
+    }
+    CHECK(edges.str() == "0 1 4\n1 2 -2\n");
+    {
+        GraphWriter w(dot);
+        w.write(CSRGraph(g), GraphWriter::DOT);
+    }
+    CHECK(dot.str() == "graph G {\n  0;\n  1;\n  2;\n  0 -- 1 [weight=4];\n  1 -- 2 [weight=-2];\n}\n");
+    {
+        GraphWriter w(json);
+        w.write(g, GraphWriter::JSON);
+    }
+    CHECK(json.str() == "{\"vertices\": 3, \"directed\": false, \"edges\": [[0, 1, 4], [1, 2, -2]]}\n");
+
+    std::ostringstream extremes;
+    {
+        GraphWriter w(extremes);
+        w.putInt(-2147483647 - 1);
+        w.put(' ');
+        w.putInt(0);
+    }
+    CHECK(extremes.str() == "-2147483648 0");
+}
+
+TEST_CASE("Graph - directed mode") {
+    Graph g(4, true, true);
+    CHECK(g.isDirected());
+    g.addEdge(0, 1, 3);
+    g.addEdge(1, 2, 4);
+    g.addEdge(0, 1, 5);  // Updates the weight
+    CHECK(g.getAdjList()[1].neighbors->vertex == 2);
+    CHECK(g.getAdjList()[1].neighbors->next == nullptr);  // No reverse entry 1 -> 0
+    CHECK(g.getAdjList()[0].neighbors->weight == 5);
+    CHECK(g.getInAdjList()[1].neighbors->vertex == 0);
+    CHECK(g.getInAdjList()[1].neighbors->weight == 5);
+
+    g.addEdge(1, 0, 7);  // The opposite direction is a separate edge
+    g.removeEdge(0, 1);
+    CHECK(g.getAdjList()[0].neighbors == nullptr);
+    CHECK(g.getAdjList()[1].neighbors->vertex == 0);
+    CHECK(g.getInAdjList()[1].neighbors == nullptr);
+    CHECK_THROWS_AS(g.removeEdge(0, 1), std::runtime_error);
+
+    Graph u(2);
+    CHECK(u.getInAdjList() == u.getAdjList());
+    Graph noIndex(2, true);
+    CHECK(noIndex.getInAdjList() == nullptr);
+}
+
+TEST_CASE("Algorithms - directed graphs") {
+    Graph g(4, true);
+    g.addEdge(0, 1, 1);
+    g.addEdge(1, 2, 1);
+    g.addEdge(3, 0, 1);  // Not reachable from 0
+
+    Graph bfsTree = Algorithms::bfs(0, g);
+    CHECK(bfsTree.isDirected());
+    CHECK(bfsTree.getAdjList()[0].neighbors->vertex == 1);
+    CHECK(bfsTree.getAdjList()[1].neighbors->vertex == 2);
+    CHECK(bfsTree.getAdjList()[2].neighbors == nullptr);
+    CHECK(bfsTree.getAdjList()[3].neighbors == nullptr);
+
+    Graph spt = Algorithms::dijkstra(0, CSRGraph(g));
+    CHECK(spt.isDirected());
+    CHECK(spt.getAdjList()[1].neighbors->vertex == 2);
+    CHECK(spt.getAdjList()[3].neighbors == nullptr);
+
+    Graph dfsForest = Algorithms::dfs(0, g);
+    CHECK(dfsForest.getAdjList()[3].neighbors == nullptr);  // 3 is a root of its own tree
+
+    CHECK_THROWS_AS(Algorithms::prim(g), std::invalid_argument);
+    CHECK_THROWS_AS(Algorithms::kruskal(g), std::invalid_argument);
+}
+
+TEST_CASE("GraphFile - directed graphs keep their direction") {
+    const char* path = "graph_file_directed.bin";
+    GraphBuilder builder(4, true);
+    builder.addEdge(0, 1, 2);
+    builder.addEdge(2, 1, 3);
+    CSRGraph csr = builder.build();
+    CHECK(csr.isDirected());
+    CHECK(csr.getNumEntries() == 2);
+    GraphFile::write(csr, path);
+    {
+        MappedGraph mapped(path);
+        CHECK(mapped.getGraph().isDirected());
+        Graph g = mapped.toGraph();
+        CHECK(g.isDirected());
+        CHECK(g.getAdjList()[1].neighbors == nullptr);
+    }
+    std::remove(path);
+
+    std::ostringstream dot;
+    {
+        GraphWriter w(dot);
+        w.write(csr, GraphWriter::DOT);
+    }
+    CHECK(dot.str() == "digraph G {\n  0;\n  1;\n  2;\n  0 -> 1 [weight=2];\n  2 -> 1 [weight=3];\n}\n");
+}
+
+TEST_CASE("GraphFile - corrupt arrays are rejected") {
+    const char* path = "graph_file_corrupt.bin";
+    Graph g(4);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 3);
+    g.addEdge(2, 3, 4);
+    GraphFile::write(g, path);
+    CHECK_NOTHROW(MappedGraph{path});
+
+    // Header, 5 offsets, then the targets: point the first target past the last vertex
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(sizeof(GraphFileHeader) + 5 * sizeof(int32_t));
+    int32_t bad = 4;
+    file.write(reinterpret_cast<const char*>(&bad), sizeof(bad));
+    file.close();
+    CHECK_THROWS_WITH_AS(MappedGraph{path}, (std::string("Corrupt graph file: ") + path).c_str(), std::runtime_error);
+
+    // Offsets that decrease
+    GraphFile::write(g, path);
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(sizeof(GraphFileHeader) + 2 * sizeof(int32_t));
+    int32_t backwards = 0;
+    file.write(reinterpret_cast<const char*>(&backwards), sizeof(backwards));
+    file.close();
+    CHECK_THROWS_AS(MappedGraph{path}, std::runtime_error);
+    std::remove(path);
+}
+
+TEST_CASE("DeltaGraph - updates merged over the base") {
+    Graph g(5);
+    g.addEdge(0, 1, 4);
+    g.addEdge(1, 2, 1);
+    g.addEdge(2, 3, 1);
+    DeltaGraph dg(g);
+    CHECK(dg.getDeltaSize() == 0);
+
+    dg.addEdge(0, 1, 10);   // Re-weight a base edge
+    dg.removeEdge(2, 3);    // Delete a base edge
+    dg.addEdge(3, 4, 2);    // New edge
+    dg.addEdge(0, 2, 3);
+    CHECK(dg.hasEdge(1, 0));
+    CHECK_FALSE(dg.hasEdge(3, 2));
+    CHECK(dg.hasEdge(4, 3));
+    CHECK_THROWS_AS(dg.removeEdge(2, 3), std::runtime_error);
+    CHECK_THROWS_AS(dg.addEdge(1, 1), std::invalid_argument);
+    CHECK_THROWS_AS(dg.addEdge(0, 9), std::out_of_range);
+
+    Graph spt = Algorithms::dijkstra(0, dg);
+    CHECK(spt.getAdjList()[1].neighbors->vertex == 2);  // 0 -> 2 -> 1 (4) beats the new 0 -> 1 (10)
+    Graph bfsTree = Algorithms::bfs(0, dg);
+    CHECK(bfsTree.getAdjList()[3].neighbors == nullptr);  // 3 is no longer reachable
+
+    dg.addEdge(0, 1, 4);  // Back to the base weight: no override needed
+    dg.compact();
+    CHECK(dg.getDeltaSize() == 0);
+    CSRGraph merged = dg.snapshot();
+    CHECK(merged.getNumEntries() == 2 * 4);
+    CHECK(dg.hasEdge(0, 2));
+    CHECK_FALSE(dg.hasEdge(2, 3));
+}
+
+TEST_CASE("DeltaGraph - background compaction keeps concurrent updates") {
+    Graph g(100);
+    for (int i = 0; i + 1 < 100; i++) {
+        g.addEdge(i, i + 1, 1);
+    }
+    DeltaGraph dg(g);
+    dg.startBackgroundCompaction(1, 1);
+    for (int i = 0; i + 2 < 100; i++) {
+        dg.addEdge(i, i + 2, 5);
+        if (i % 3 == 0) dg.removeEdge(i, i + 1);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    dg.stopBackgroundCompaction();
+    dg.compact();
+    CHECK(dg.getDeltaSize() == 0);
+    for (int i = 0; i + 2 < 100; i++) {
+        CHECK(dg.hasEdge(i, i + 2));
+        CHECK(dg.hasEdge(i, i + 1) == (i % 3 != 0));
+    }
+}
+
+// Total weight of a spanning forest returned by the MST algorithms
+static long long forestWeight(const Graph& forest) {
+    long long total = 0;
+    for (int v = 0; v < forest.getNumVertices(); v++) {
+        for (NeighborVer* n = forest.getAdjList()[v].neighbors; n; n = n->next) {
+            if (v < n->vertex) total += n->weight;
+        }
+    }
+    return total;
+}
+
+TEST_CASE("DynamicMST - insertions match recomputation") {
+    Graph g(6);
+    g.addEdge(0, 1, 4);
+    g.addEdge(1, 2, 6);
+    g.addEdge(0, 2, 5);
+    g.addEdge(3, 4, 1);
+    DynamicMST mst(g);
+    CHECK(mst.getTotalWeight() == 10);
+    CHECK(mst.getNumTreeEdges() == 3);
+    CHECK_FALSE(mst.connected(0, 3));
+    CHECK(mst.pathMax(1, 2) == 5);
+
+    CHECK(mst.insertEdge(2, 3, 7));   // Joins two trees
+    CHECK(mst.insertEdge(1, 4, 2));   // Replaces the 7 on the cycle 1-0-2-3-4
+    CHECK(mst.getTotalWeight() == 12);
+    CHECK_FALSE(mst.insertEdge(0, 4, 9));
+    CHECK(mst.decreaseWeight(0, 4, 1));  // Now lighter than anything on its cycle
+    CHECK(mst.getTotalWeight() == 9);
+    CHECK(mst.decreaseWeight(0, 4, 0));  // Tree edge: only its weight changes
+    CHECK(mst.getTotalWeight() == 8);
+    CHECK_THROWS_AS(mst.decreaseWeight(0, 4, 3), std::invalid_argument);
+    CHECK_THROWS_AS(mst.insertEdge(0, 0, 1), std::invalid_argument);
+    CHECK_THROWS_AS(mst.insertEdge(0, 6, 1), std::out_of_range);
+
+    // Random insertions checked against Kruskal on the accumulated graph
+    std::srand(7);
+    Graph all(30);
+    DynamicMST incremental(30);
+    for (int i = 0; i < 300; i++) {
+        int u = std::rand() % 30, v = std::rand() % 30;
+        if (u == v) continue;
+        int w = std::rand() % 100;
+        NeighborVer* n = all.getAdjList()[u].neighbors;
+        while (n && n->vertex != v) n = n->next;
+        if (n && n->weight <= w) continue;  // Keep to insertions and decreases
+        all.addEdge(u, v, w);
+        incremental.decreaseWeight(u, v, w);
+        CHECK(incremental.getTotalWeight() == forestWeight(Algorithms::kruskal(all)));
+    }
+    CHECK(forestWeight(incremental.toGraph()) == incremental.getTotalWeight());
+}
+
+TEST_CASE("Graph - incremental connectivity") {
+    Graph g(5);
+    CHECK(g.getNumComponents() == 5);
+    g.addEdge(0, 1);
+    g.addEdge(2, 3);
+    CHECK(g.connected(0, 1));
+    CHECK_FALSE(g.connected(1, 2));
+    CHECK(g.getNumComponents() == 3);
+    g.addEdge(1, 2);
+    g.addEdge(1, 2, 5);  // Weight update, no new union
+    CHECK(g.connected(0, 3));
+    CHECK(g.getNumComponents() == 2);
+
+    g.removeEdge(1, 2);  // Splits the component; the next query rebuilds
+    CHECK_FALSE(g.connected(0, 3));
+    CHECK(g.getNumComponents() == 3);
+    CHECK_THROWS_AS(g.connected(0, 5), std::out_of_range);
+
+    Graph d(3, true);
+    d.addEdge(2, 0);
+    CHECK(d.connected(0, 2));  // Weakly connected
+    CHECK(d.getNumComponents() == 2);
+}
+
+TEST_CASE("Reordering - permutations and relabeling") {
+    // A path 0-1-2-3-4-5 with scrambled labels
+    int path[] = {3, 0, 5, 1, 4, 2};
+    Graph g(6);
+    for (int i = 0; i + 1 < 6; i++) {
+        g.addEdge(path[i], path[i + 1], i + 1);
+    }
+
+    Reordering rcm(g, Reordering::REVERSE_CUTHILL_MCKEE);
+    CSRGraph relabeled = rcm.apply(CSRGraph(g));
+    for (int v = 0; v < 6; v++) {
+        CHECK(rcm.toOld(rcm.toNew(v)) == v);
+        for (int i = relabeled.getOffsets()[v]; i < relabeled.getOffsets()[v + 1]; i++) {
+            int diff = relabeled.getTargets()[i] - v;
+            CHECK((diff == 1 || diff == -1));  // Bandwidth 1 along the path
+        }
+    }
+
+    // A BFS tree on the relabeled graph maps back to the tree on the original graph
+    Graph tree = rcm.mapBack(Algorithms::bfs(rcm.toNew(3), relabeled));
+    Graph expected = Algorithms::bfs(3, g);
+    CHECK(forestWeight(tree) == forestWeight(expected));
+    for (int v = 0; v < 6; v++) {
+        for (NeighborVer* n = expected.getAdjList()[v].neighbors; n; n = n->next) {
+            CHECK(tree.connected(v, n->vertex));
+        }
+    }
+
+    Graph star(5);
+    for (int i = 1; i < 5; i++) {
+        star.addEdge(4, i - 1);
+    }
+    Reordering byDegree(star, Reordering::DEGREE_SORT);
+    CHECK(byDegree.toOld(0) == 4);  // The hub comes first
+    Graph moved = byDegree.apply(star);
+    CHECK(moved.getAdjList()[0].neighbors != nullptr);
+    CHECK(moved.getNumComponents() == 1);
+
+    Reordering bfsOrder(star, Reordering::BFS_ORDER);
+    CHECK(bfsOrder.toOld(0) == 0);
+    CHECK(bfsOrder.toOld(1) == 4);
+    CHECK_THROWS_AS(bfsOrder.toNew(5), std::out_of_range);
+}
+
+TEST_CASE("AlgorithmWorkspace - reused across queries") {
+    Graph g(6);
+    g.addEdge(0, 1, 4);
+    g.addEdge(0, 2, 1);
+    g.addEdge(2, 1, 2);
+    g.addEdge(1, 3, 5);
+    g.addEdge(4, 5, 3);
+    CSRGraph csr(g);
+    AlgorithmWorkspace ws;
+
+    Graph sp = Algorithms::dijkstra(0, g, ws);
+    CHECK(ws.getCapacity() >= 6);
+    CHECK(ws.getDistance(1) == 3);
+    CHECK(ws.getParent(1) == 2);
+    CHECK(ws.getDistance(3) == 8);
+    CHECK_FALSE(ws.wasReached(4));
+    CHECK(ws.getDistance(4) == INT_MAX);
+    CHECK(forestWeight(sp) == forestWeight(Algorithms::dijkstra(0, csr)));
+
+    // A new query must not see the stamps of the previous one
+    Graph tree = Algorithms::bfs(4, g, ws);
+    CHECK(ws.getDistance(5) == 1);
+    CHECK_FALSE(ws.wasReached(0));
+    CHECK(tree.getNumComponents() == 5);
+
+    Graph mst = Algorithms::prim(g, ws);
+    CHECK(forestWeight(mst) == forestWeight(Algorithms::prim(csr)));
+    CHECK(ws.getDistance(1) == 2);
+
+    Graph a = Algorithms::dfs(3, g, ws);
+    Graph b = Algorithms::dfs(3, csr);
+    for (int v = 0; v < 6; v++) {
+        NeighborVer* x = a.getAdjList()[v].neighbors;
+        NeighborVer* y = b.getAdjList()[v].neighbors;
+        for (; x && y; x = x->next, y = y->next) {
+            CHECK(x->vertex == y->vertex);
+        }
+        CHECK(x == y);
+    }
+    CHECK(ws.getParent(3) == -1);
+    CHECK(ws.getDistance(0) == 3);
+
+    // The arrays grow for a larger graph and the workspace keeps working
+    Graph path(100);
+    for (int i = 0; i + 1 < 100; i++) {
+        path.addEdge(i, i + 1);
+    }
+    Algorithms::bfs(0, path, ws);
+    CHECK(ws.getCapacity() >= 100);
+    CHECK(ws.getDistance(99) == 99);
+    CHECK_THROWS_AS(ws.getDistance(100), std::out_of_range);
+    CHECK_THROWS_AS(Algorithms::bfs(100, path, ws), std::out_of_range);
+}
+
+// Counts undirected edges and checks there are no self-loops
+static int countEdges(const Graph& g) {
+    int entries = 0;
+    for (int v = 0; v < g.getNumVertices(); v++) {
+        for (NeighborVer* n = g.getAdjList()[v].neighbors; n; n = n->next) {
+            CHECK(n->vertex != v);
+            CHECK(n->weight >= 1);
+            CHECK(n->weight <= 100);
+            entries++;
+        }
+    }
+    return entries / 2;
+}
+
+TEST_CASE("Generators - shapes and reproducible seeds") {
+    Graph er = Generators::erdosRenyi(200, 600, 7);
+    int erEdges = countEdges(er);
+    CHECK(erEdges <= 600);
+    CHECK(erEdges > 550);
+    CHECK(forestWeight(Algorithms::kruskal(er)) == forestWeight(Algorithms::kruskal(Generators::erdosRenyi(200, 600, 7))));
+    CHECK(countEdges(Generators::erdosRenyi(200, 600, 8)) > 550);
+
+    Graph rmat = Generators::rmat(10, 5000, 1);
+    CHECK(rmat.getNumVertices() == 1024);
+    countEdges(rmat);
+    CSRGraph rmatCsr(rmat);
+    int maxDegree = 0;
+    for (int v = 0; v < 1024; v++) {
+        if (rmatCsr.degree(v) > maxDegree) maxDegree = rmatCsr.degree(v);
+    }
+    CHECK(maxDegree > 10 * rmatCsr.getNumEntries() / 1024);  // Skewed: hubs far above the average degree
+
+    Graph ba = Generators::barabasiAlbert(500, 3, 2);
+    CHECK(countEdges(ba) == 3 * 4 / 2 + (500 - 4) * 3);
+    CHECK(ba.getNumComponents() == 1);
+
+    Graph grid = Generators::grid(10, 20, 3);
+    CHECK(countEdges(grid) == 10 * 19 + 9 * 20);
+    CHECK(grid.getNumComponents() == 1);
+
+    Graph path = Generators::path(1000, 4);
+    CHECK(countEdges(path) == 999);
+    CHECK(Generators::path(1, 4).getNumVertices() == 1);
+
+    CHECK_THROWS_AS(Generators::erdosRenyi(0, 1, 1), std::invalid_argument);
+    CHECK_THROWS_AS(Generators::barabasiAlbert(3, 3, 1), std::invalid_argument);
+    CHECK_THROWS_AS(Generators::rmat(0, 10, 1), std::invalid_argument);
+    CHECK_THROWS_AS(Generators::rmat(4, 10, 1, 10, 1.0, 0.0, 0.0), std::invalid_argument);  // Only self-loops
+    CHECK_THROWS_AS(Generators::rmat(4, 10, 1, 10, 0.5, 0.0, 0.0), std::invalid_argument);
+    CHECK(Generators::rmat(4, 10, 1, 10, 0.5, 0.0, 0.1).getNumVertices() == 16);
+    CHECK_THROWS_AS(Generators::grid(2, 2, 1, 0), std::invalid_argument);
+}
+
+TEST_CASE("EdgeBuffer - radix sort by weight") {
+    EdgeBuffer edges(2);
+    int weights[] = {5, -3, 70000, 5, INT_MIN, 0, INT_MAX, -3, 256, 1};
+    for (int i = 0; i < 10; i++) {
+        edges.add(i, i + 1, weights[i]);
+    }
+    CHECK(edges.getSize() == 10);
+    CHECK(edges.getSrc(2) == 2);
+    CHECK(edges.getDest(2) == 3);
+    CHECK(edges.getWeight(2) == 70000);
+
+    int order[10];
+    edges.sortByWeight(order);
+    int expected[] = {4, 1, 7, 5, 9, 0, 3, 8, 2, 6};  // Equal weights keep insertion order
+    for (int i = 0; i < 10; i++) {
+        CHECK(order[i] == expected[i]);
+    }
+
+    // Weights sharing their upper bytes (only one pass runs), compared with std::stable_sort
+    edges.clear();
+    unsigned int state = 7;
+    for (int i = 0; i < 1000; i++) {
+        state = state * 1664525u + 1013904223u;
+        edges.add(i, i, static_cast<int>(state >> 24));
+    }
+    int sorted[1000];
+    int reference[1000];
+    edges.sortByWeight(sorted);
+    for (int i = 0; i < 1000; i++) {
+        reference[i] = i;
+    }
+    std::stable_sort(reference, reference + 1000,
+                     [&edges](int a, int b) { return edges.getWeight(a) < edges.getWeight(b); });
+    for (int i = 0; i < 1000; i++) {
+        CHECK(sorted[i] == reference[i]);
+    }
+}
+
+TEST_CASE("Algorithms - Kruskal with negative and equal weights") {
+    Graph g(5);
+    g.addEdge(0, 1, -2);
+    g.addEdge(1, 2, 3);
+    g.addEdge(0, 2, 3);
+    g.addEdge(2, 3, -7);
+    g.addEdge(3, 4, 3);
+    g.addEdge(1, 4, 10);
+    Graph mst = Algorithms::kruskal(g);
+    CHECK(forestWeight(mst) == forestWeight(Algorithms::prim(g)));
+    CHECK(forestWeight(mst) == -3);
+
+    // Random weights in [-1000, 1000) with many repeats
+    Graph er = Generators::erdosRenyi(300, 1500, 11, 2000);
+    Graph shifted(300);
+    for (int u = 0; u < 300; u++) {
+        for (NeighborVer* n = er.getAdjList()[u].neighbors; n; n = n->next) {
+            if (u < n->vertex) shifted.addEdge(u, n->vertex, n->weight - 1000);
+        }
+    }
+    CHECK(forestWeight(Algorithms::kruskal(shifted)) == forestWeight(Algorithms::prim(shifted)));
+}
+
+TEST_CASE("AlgorithmStats - counters per call") {
+    Graph g(5);
+    g.addEdge(0, 1, 4);
+    g.addEdge(0, 2, 1);
+    g.addEdge(2, 1, 2);
+    g.addEdge(1, 3, 5);
+
+    Algorithms::dijkstra(0, g);
+    AlgorithmStats s = Algorithms::lastStats();
+    if (!Algorithms::statsEnabled()) {
+        CHECK(s.verticesSettled == 0);
+        CHECK(s.heapPushes == 0);
+        return;
+    }
+    CHECK(s.verticesSettled == 4);  // Vertex 4 is unreachable
+    CHECK(s.edgesScanned == 8);
+    CHECK(s.edgesRelaxed == 4);     // 0->1 (4), 0->2, 2->1 (3), 1->3
+    CHECK(s.heapPushes == 5);
+    CHECK(s.heapPops == 5);
+    CHECK(s.staleEntries == 1);
+
+    Algorithms::bfs(0, g);
+    s = Algorithms::lastStats();
+    CHECK(s.verticesSettled == 4);
+    CHECK(s.edgesRelaxed == 3);
+    CHECK(s.heapPushes == 0);       // Counters restart with every call
+
+    Algorithms::kruskal(g);
+    s = Algorithms::lastStats();
+    CHECK(s.heapPushes == 0);       // Kruskal radix-sorts its edges instead
+    CHECK(s.edgesScanned == 8);
+    CHECK(s.edgesRelaxed == 3);
+    CHECK(s.findCalls > 0);
+    CHECK(s.findSteps < s.findCalls);
+}
+
+TEST_CASE("Tracer - phases exported as Chrome trace") {
+    Graph g = Generators::grid(5, 5, 1);
+    ChromeTraceExporter exporter;
+    Tracer::setTracer(&exporter);
+    Algorithms::dijkstra(0, g);
+    Algorithms::kruskal(g);
+    CHECK_THROWS_AS(Algorithms::bfs(30, g), std::out_of_range);
+    Tracer::setTracer(nullptr);
+    Algorithms::prim(g);  // Not recorded
+
+    CHECK(exporter.getNumEvents() == 9);  // 4 + 4 phases, and bfs stopped in "validate"
+    std::ostringstream out;
+    exporter.write(out);
+    std::string json = out.str();
+    CHECK(json.find("{\"traceEvents\": [") == 0);
+    CHECK(json.find("\"name\": \"search\", \"cat\": \"dijkstra\", \"ph\": \"X\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"build\", \"cat\": \"kruskal\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"validate\", \"cat\": \"bfs\"") != std::string::npos);
+    CHECK(json.find("\"cat\": \"prim\"") == std::string::npos);
+
+    const char* path = "tracer_test.json";
+    exporter.save(path);
+    std::ifstream in(path);
+    std::stringstream saved;
+    saved << in.rdbuf();
+    CHECK(saved.str() == json);
+    std::remove(path);
+
+    exporter.clear();
+    CHECK(exporter.getNumEvents() == 0);
+}
+
+TEST_CASE("AllocationTracker - per component and per call") {
+    AllocationTracker::Counters graphBefore = AllocationTracker::get(AllocationTracker::GRAPH);
+    Graph g = Generators::path(50, 1);
+    Algorithms::dijkstra(0, g);
+    AllocationTracker::CallStats call = AllocationTracker::lastCall();
+    AllocationTracker::Counters graphAfter = AllocationTracker::get(AllocationTracker::GRAPH);
+    AllocationTracker::Counters workspace = AllocationTracker::get(AllocationTracker::WORKSPACE);
+
+    std::ostringstream out;
+    AllocationTracker::report(out);
+    CHECK(out.str().find("PriorityQueue") != std::string::npos);
+
+    if (!AllocationTracker::enabled()) {
+        CHECK(call.algorithm == nullptr);
+        CHECK(graphAfter.allocations == 0);
+        return;
+    }
+    CHECK(graphAfter.allocations - graphBefore.allocations >= 2 * 49 + 2 * 49);  // Input and tree nodes
+    CHECK(workspace.allocations >= 8);
+    CHECK(std::string(call.algorithm) == "dijkstra");
+    CHECK(call.allocations > 0);
+    CHECK(call.peakBytes > 0);
+    CHECK(call.peakBytes <= call.bytes);
+
+    // Freed memory is charged back to the component that allocated it
+    long long live = AllocationTracker::get(AllocationTracker::UNION_FIND).liveBytes;
+    {
+        UnionFind uf(100);
+        CHECK(AllocationTracker::get(AllocationTracker::UNION_FIND).liveBytes == live + 2 * 100 * (long long)sizeof(int));
+    }
+    CHECK(AllocationTracker::get(AllocationTracker::UNION_FIND).liveBytes == live);
+}
+
+TEST_CASE("Simd - every level matches the scalar kernels") {
+    std::vector<int> values(1000);
+    unsigned int state = 12345;
+    for (size_t i = 0; i < values.size(); i++) {
+        state = state * 1103515245u + 12345u;
+        values[i] = static_cast<int>(state >> 8) % 100000;
+    }
+    values[637] = -5;
+    values[901] = -5;  // Same minimum later: the first position must win
+
+    uint64_t next[37], visited[37];
+    for (int i = 0; i < 37; i++) {
+        next[i] = 0x9E3779B97F4A7C15ull * (i + 1);
+        visited[i] = 0xC2B2AE3D27D4EB4Full * (i + 7);
+    }
+
+    Simd::Level original = Simd::getLevel();
+    Simd::setLevel(Simd::SCALAR);
+    uint64_t scalarNext[37], scalarVisited[37];
+    std::copy(next, next + 37, scalarNext);
+    std::copy(visited, visited + 37, scalarVisited);
+    long long scalarCount = Simd::frontierUpdate(scalarNext, scalarVisited, 37);
+
+    Simd::Level levels[] = {Simd::SCALAR, Simd::AVX2, Simd::AVX512};
+    for (Simd::Level level : levels) {
+        Simd::setLevel(level);
+        CHECK(Simd::getLevel() <= Simd::supportedLevel());
+        for (int count = 0; count <= 1000; count += (count < 70 ? 1 : 97)) {
+            int expected = -1;
+            bool negative = false;
+            for (int i = 0; i < count; i++) {
+                if (expected == -1 || values[i] < values[expected]) expected = i;
+                if (values[i] < 0) negative = true;
+            }
+            CHECK(Simd::minIndex(values.data(), count) == expected);
+            CHECK(Simd::anyNegative(values.data(), count) == negative);
+            CHECK_FALSE(Simd::anyNegative(values.data(), count < 637 ? count : 637));
+        }
+
+        uint64_t n[37], v[37];
+        std::copy(next, next + 37, n);
+        std::copy(visited, visited + 37, v);
+        CHECK(Simd::frontierUpdate(n, v, 37) == scalarCount);
+        CHECK(std::equal(n, n + 37, scalarNext));
+        CHECK(std::equal(v, v + 37, scalarVisited));
+
+        // Min-plus update: unreachable entries of 'through' never change the row
+        for (int count = 0; count <= 45; count++) {
+            std::vector<int> row(values.begin(), values.begin() + count);
+            std::vector<int> through(values.begin() + 500, values.begin() + 500 + count);
+            for (int j = 0; j < count; j += 3) through[j] = INT_MAX;
+            std::vector<int> expected(row);
+            for (int j = 0; j < count; j++) {
+                if (through[j] != INT_MAX && through[j] - 40000 < expected[j]) expected[j] = through[j] - 40000;
+            }
+            Simd::minPlusRow(row.data(), through.data(), -40000, count);
+            CHECK(row == expected);
+        }
+
+        // Sums beyond the int range saturate instead of wrapping around
+        for (int count = 0; count <= 45; count++) {
+            std::vector<int> row(count), up(count), down(count);
+            for (int j = 0; j < count; j++) {
+                row[j] = (j % 4 == 0) ? INT_MAX : 2000000000 - j;
+                up[j] = (j % 5 == 0) ? INT_MAX : 1000000000 + j * 20000000;
+                down[j] = (j % 5 == 0) ? INT_MAX : -1000000000 - j * 20000000;
+            }
+            std::vector<int> high(row), low(row), expectedHigh(row), expectedLow(row);
+            for (int j = 0; j < count; j++) {
+                long long sum = 1500000000LL + up[j];
+                if (up[j] != INT_MAX && sum < expectedHigh[j]) expectedHigh[j] = static_cast<int>(sum);
+                sum = -2000000000LL + down[j];
+                if (down[j] != INT_MAX) expectedLow[j] = sum < INT_MIN ? INT_MIN : static_cast<int>(sum);
+            }
+            Simd::minPlusRow(high.data(), up.data(), 1500000000, count);
+            Simd::minPlusRow(low.data(), down.data(), -2000000000, count);
+            CHECK(high == expectedHigh);
+            CHECK(low == expectedLow);
+        }
+    }
+    Simd::setLevel(original);
+    CHECK(Simd::name(Simd::SCALAR) == std::string("scalar"));
+}
+
+TEST_CASE("Algorithms - bitmap BFS distances") {
+    Graph g = Generators::rmat(9, 1500, 5);
+    CSRGraph csr(g);
+    std::vector<int> dist(g.getNumVertices());
+    AlgorithmWorkspace ws;
+    Algorithms::bfs(3, g, ws);
+    Algorithms::bfsDistances(3, csr, dist.data());
+    for (int v = 0; v < g.getNumVertices(); v++) {
+        CHECK(dist[v] == ws.getDistance(v));
+    }
+    CHECK_THROWS_AS(Algorithms::bfsDistances(-1, csr, dist.data()), std::out_of_range);
+
+    // Directed: only out-edges are followed
+    Graph d(3, true);
+    d.addEdge(0, 1);
+    d.addEdge(2, 1);
+    int directedDist[3];
+    Algorithms::bfsDistances(0, CSRGraph(d), directedDist);
+    CHECK(directedDist[1] == 1);
+    CHECK(directedDist[2] == INT_MAX);
+    CHECK(CSRGraph(d).hasNegativeWeights() == false);
+}
+
+TEST_CASE("PriorityQueue - linear scan below the limit, heap above") {
+    PriorityQueue pq(4);
+    // Small queue: equal weights come out in insertion order of their slots (first minimum wins)
+    pq.insert(0, 1, 5);
+    pq.insert(0, 2, 3);
+    pq.insert(0, 3, 3);
+    CHECK(pq.extractMin().dest == 2);
+    CHECK(pq.extractMin().dest == 3);
+    CHECK(pq.extractMin().dest == 1);
+    CHECK(pq.isEmpty());
+
+    // Grow well past the limit, drain below it, grow again: always sorted output
+    unsigned int state = 99;
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 500; i++) {
+            state = state * 1664525u + 1013904223u;
+            pq.insert(i, round, static_cast<int>(state >> 20));
+        }
+        int keep = (round == 2) ? 0 : 10;
+        int previous = -1;
+        while (pq.getSize() > keep) {
+            Edge e = pq.extractMin();
+            CHECK(e.weight >= previous);
+            previous = e.weight;
+        }
+        CHECK(pq.getSize() == keep);
+    }
+    CHECK(pq.isEmpty());
+
+    for (int i = 0; i < 100; i++) {
+        pq.insert(i, i, 100 - i);
+    }
+    pq.clear();
+    CHECK(pq.isEmpty());
+    pq.insert(1, 2, 7);
+    pq.insert(1, 3, 6);
+    CHECK(pq.extractMin().weight == 6);
+}
+
+TEST_CASE("IndexedHeap - decrease-key keeps one entry per vertex") {
+    IndexedHeap heap(8);
+    CHECK(heap.pushOrDecrease(3, 10));
+    CHECK(heap.pushOrDecrease(5, 7));
+    CHECK(heap.pushOrDecrease(1, 9));
+    CHECK_FALSE(heap.pushOrDecrease(3, 2));   // Lowered in place
+    CHECK_FALSE(heap.pushOrDecrease(5, 8));   // Larger key: unchanged
+    CHECK(heap.getSize() == 3);
+    CHECK(heap.contains(3));
+    CHECK_FALSE(heap.contains(0));
+
+    int key;
+    CHECK(heap.extractMin(key) == 3);
+    CHECK(key == 2);
+    CHECK_FALSE(heap.contains(3));
+    CHECK(heap.extractMin(key) == 5);
+    CHECK(key == 7);
+    CHECK(heap.extractMin(key) == 1);
+    CHECK(heap.isEmpty());
+    CHECK_THROWS_AS(heap.extractMin(key), std::underflow_error);
+
+    // Random keys, lowered many times: output sorted, never more than one slot per vertex
+    const int n = 500;
+    heap.reserve(n);
+    unsigned int state = 5;
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < 3 * n; i++) {
+            state = state * 1664525u + 1013904223u;
+            heap.pushOrDecrease(static_cast<int>((state >> 8) % n), static_cast<int>(state >> 20));
+            CHECK(heap.getSize() <= n);
+        }
+        if (round == 1) {
+            heap.clear();  // Positions reset: everything can be pushed again
+            CHECK_FALSE(heap.contains(0));
+            continue;
+        }
+        int previous = -1;
+        while (!heap.isEmpty()) {
+            heap.extractMin(key);
+            CHECK(key >= previous);
+            previous = key;
+        }
+    }
+}
+
+TEST_CASE("Algorithms - Prim spanning forest and start vertex") {
+    Graph g(7);
+    g.addEdge(0, 1, 4);
+    g.addEdge(1, 2, 1);
+    g.addEdge(0, 2, 2);
+    g.addEdge(3, 4, -3);
+    g.addEdge(4, 5, 6);
+    g.addEdge(3, 5, 5);   // Vertex 6 is isolated
+    CSRGraph csr(g);
+    long long expected = forestWeight(Algorithms::kruskal(g));
+    CHECK(expected == 5);
+    for (int start = 0; start < 7; start++) {
+        Graph mst = Algorithms::prim(g, start);
+        CHECK(forestWeight(mst) == expected);
+        CHECK(mst.getNumComponents() == 3);
+        CHECK(forestWeight(Algorithms::prim(csr, start)) == expected);
+    }
+
+    AlgorithmWorkspace ws;
+    Algorithms::prim(g, ws, 4, Algorithms::INDEXED_HEAP);
+    CHECK(ws.getParent(4) == -1);   // Roots: the start vertex, then the lowest unreached vertices
+    CHECK(ws.getParent(0) == -1);
+    CHECK(ws.getParent(6) == -1);
+    CHECK(ws.getParent(3) == 4);
+    CHECK(ws.getDistance(5) == 5);
+    CHECK(ws.getDistance(1) == 1);
+    if (Algorithms::statsEnabled()) {
+        CHECK(Algorithms::lastStats().heapPushes == 7);  // One entry per vertex
+    }
+
+    CHECK_THROWS_AS(Algorithms::prim(g, 7), std::out_of_range);
+    CHECK_THROWS_AS(Algorithms::prim(csr, -1), std::out_of_range);
+
+    // Random disconnected graph: every start vertex gives the weight of the Kruskal forest
+    Graph er = Generators::erdosRenyi(400, 300, 21, 50);
+    expected = forestWeight(Algorithms::kruskal(er));
+    for (int start = 0; start < 400; start += 37) {
+        CHECK(forestWeight(Algorithms::prim(er, ws, start)) == expected);
+    }
+}
+
+TEST_CASE("Graph - entry count kept by every update") {
+    Graph g(4);
+    CHECK(g.getNumEntries() == 0);
+    g.addEdge(0, 1, 3);
+    g.addEdge(1, 2);
+    g.addEdge(1, 0, 7);   // Existing edge: only the weight changes
+    CHECK(g.getNumEntries() == 4);
+    g.addTreeEdge(2, 3);
+    CHECK(g.getNumEntries() == 5);
+    g.removeEdge(3, 2);   // Only the 2 -> 3 entry exists
+    CHECK(g.getNumEntries() == 4);
+    g.removeEdge(0, 1);
+    CHECK(g.getNumEntries() == 2);
+    CHECK_THROWS_AS(g.removeEdge(0, 3), std::runtime_error);
+    CHECK(g.getNumEntries() == 2);
+    CHECK(CSRGraph(g).getNumEntries() == g.getNumEntries());
+
+    Graph d(3, true, true);
+    d.addEdge(0, 1);
+    d.addEdge(1, 0);
+    d.addEdge(0, 1, 5);
+    CHECK(d.getNumEntries() == 2);
+    d.removeEdge(1, 0);
+    CHECK(d.getNumEntries() == 1);
+
+    // CSRGraph sizes its arrays from the count: the rows must end exactly at it
+    CSRGraph csr(d);
+    CHECK(csr.getOffsets()[3] == d.getNumEntries());
+    CHECK(csr.getTargets()[0] == 1);
+    CHECK(csr.getWeights()[0] == 5);
+}
+
+TEST_CASE("Algorithms - Prim variants agree and dense CSR graphs use the array scan") {
+    Graph path(50);
+    for (int i = 0; i + 1 < 50; i++) {
+        path.addEdge(i, i + 1, i % 7);
+    }
+    CHECK(Algorithms::choosePrimVariant(CSRGraph(path)) == Algorithms::INDEXED_HEAP);
+
+    // 1000 vertices: the scan starts at about 25% of all pairs
+    CHECK(Algorithms::choosePrimVariant(CSRGraph(Generators::erdosRenyi(1000, 50000, 3))) == Algorithms::INDEXED_HEAP);
+    CHECK(Algorithms::choosePrimVariant(CSRGraph(Generators::erdosRenyi(1000, 150000, 3))) == Algorithms::ARRAY_SCAN);
+
+    Graph dense = Generators::erdosRenyi(200, 15000, 8, 1000);
+    CSRGraph denseCsr(dense);
+    CHECK(Algorithms::choosePrimVariant(denseCsr) == Algorithms::ARRAY_SCAN);
+    if (Algorithms::statsEnabled()) {
+        Algorithms::prim(dense);  // PRIM_AUTO keeps the heap on adjacency lists
+        CHECK(Algorithms::lastStats().heapPushes == 200);
+    }
+
+    long long expected = forestWeight(Algorithms::kruskal(dense));
+    AlgorithmWorkspace ws;
+    for (int start = 0; start < 200; start += 41) {
+        CHECK(forestWeight(Algorithms::prim(dense, ws, start, Algorithms::ARRAY_SCAN)) == expected);
+        CHECK(forestWeight(Algorithms::prim(dense, ws, start, Algorithms::INDEXED_HEAP)) == expected);
+        CHECK(forestWeight(Algorithms::prim(denseCsr, start, Algorithms::ARRAY_SCAN)) == expected);
+        CHECK(forestWeight(Algorithms::prim(denseCsr, start)) == expected);
+    }
+
+    // Several components, negative and INT_MAX weights: the scan must not split a tree
+    // when the only edge left into it weighs INT_MAX
+    Graph g(8);
+    g.addEdge(0, 1, INT_MAX);
+    g.addEdge(1, 2, -4);
+    g.addEdge(0, 2, 6);
+    g.addEdge(3, 4, INT_MAX);
+    g.addEdge(5, 6, 2);
+    g.addEdge(6, 7, 1);
+    g.addEdge(5, 7, 3);
+    CSRGraph csr(g);
+    for (int start = 0; start < 8; start++) {
+        Graph a = Algorithms::prim(g, ws, start, Algorithms::ARRAY_SCAN);
+        CHECK(a.getNumComponents() == 3);
+        CHECK(forestWeight(a) == 5LL + INT_MAX);
+        CHECK(ws.getParent(start) == -1);
+        CHECK(forestWeight(Algorithms::prim(g, start, Algorithms::INDEXED_HEAP)) == forestWeight(a));
+        Graph b = Algorithms::prim(csr, start, Algorithms::ARRAY_SCAN);
+        CHECK(b.getNumComponents() == 3);
+        CHECK(forestWeight(b) == forestWeight(a));
+        CHECK(forestWeight(Algorithms::prim(csr, start, Algorithms::INDEXED_HEAP)) == forestWeight(a));
+    }
+    if (Algorithms::statsEnabled()) {
+        Algorithms::prim(g, 0, Algorithms::ARRAY_SCAN);
+        CHECK(Algorithms::lastStats().verticesSettled == 8);
+        CHECK(Algorithms::lastStats().heapPushes == 0);
+    }
+}
+
+TEST_CASE("ThreadPool - parallelFor covers every index once") {
+    ThreadPool pool(4);
+    CHECK(pool.getNumThreads() == 4);
+    const int n = 100000;
+    std::vector<std::atomic<int>> hits(n);
+    for (int i = 0; i < n; i++) hits[i] = 0;
+
+    int grains[] = {0, 1, 7, 1000, n};
+    for (int grain : grains) {
+        pool.parallelFor(0, n, grain, [&hits, &pool](int begin, int end, int thread) {
+            CHECK(begin < end);
+            CHECK((thread >= 0 && thread < pool.getNumThreads()));
+            for (int i = begin; i < end; i++) hits[i]++;
+        });
+    }
+    bool all = true;
+    for (int i = 0; i < n; i++) {
+        if (hits[i] != 5) all = false;
+    }
+    CHECK(all);
+    pool.parallelFor(5, 5, 1, [](int, int, int) { CHECK(false); });  // Empty range
+
+    // Per-thread partial sums, with uneven work per index so that threads steal
+    PerThread<long long> sums(pool);
+    CHECK(sums.size() == 4);
+    pool.parallelFor(0, 2000, 1, [&sums](int begin, int end, int thread) {
+        for (int i = begin; i < end; i++) {
+            volatile long long spin = 0;
+            for (int k = 0; k < (i < 200 ? 2000 : 10); k++) spin = spin + k;
+            sums[thread] += i;
+        }
+    });
+    long long total = 0;
+    for (int t = 0; t < sums.size(); t++) total += sums[t];
+    CHECK(total == 1999LL * 2000 / 2);
+}
+
+TEST_CASE("ThreadPool - exceptions, nesting and concurrent callers") {
+    ThreadPool pool(3, true);
+    CHECK_THROWS_AS(pool.parallelFor(0, 1000, 10, [](int begin, int, int) {
+        if (begin == 500) throw std::runtime_error("chunk failed");
+    }), std::runtime_error);
+
+    // A nested loop runs on the thread of the outer body
+    std::atomic<int> inner(0);
+    pool.parallelFor(0, 30, 1, [&pool, &inner](int, int, int thread) {
+        pool.parallelFor(0, 10, 1, [&inner, thread](int begin, int end, int nestedThread) {
+            CHECK(nestedThread == thread);
+            CHECK(ThreadPool::currentThread() == thread);
+            inner += end - begin;
+        });
+    });
+    CHECK(inner == 300);
+
+    // Two outside threads share the pool
+    std::atomic<long long> total(0);
+    auto job = [&pool, &total]() {
+        for (int round = 0; round < 20; round++) {
+            pool.parallelFor(0, 1000, 16, [&total](int begin, int end, int) {
+                total += end - begin;
+            });
+        }
+    };
+    std::thread other(job);
+    job();
+    other.join();
+    CHECK(total == 40000);
+}
+
+TEST_CASE("ThreadPool - parallelForEdges balances by adjacency entries") {
+    Graph g = Generators::barabasiAlbert(2000, 3, 8);
+    CSRGraph csr(g);
+    ThreadPool pool(4);
+    std::vector<int> covered(csr.getNumVertices(), 0);
+    std::atomic<long long> entries(0);
+    pool.parallelForEdges(csr, 500, [&csr, &covered, &entries](int begin, int end, int) {
+        int rangeEntries = csr.getOffsets()[end] - csr.getOffsets()[begin];
+        // A range only exceeds the budget when it is a single high-degree vertex
+        CHECK((rangeEntries <= 500 || end - begin == 1));
+        for (int v = begin; v < end; v++) covered[v]++;
+        entries += rangeEntries;
+    });
+    CHECK(entries == csr.getNumEntries());
+    CHECK(std::count(covered.begin(), covered.end(), 1) == csr.getNumVertices());
+}
+
+TEST_CASE("ThreadPool - shared pool and edge list loading") {
+    ThreadPool::configureShared(2);
+    CHECK(ThreadPool::shared().getNumThreads() == 2);
+    CHECK(ThreadPool::currentThread() == 0);
+
+    std::string text;
+    for (int i = 0; i < 500; i++) {
+        text += std::to_string(i) + " " + std::to_string(i + 1) + " " + std::to_string(i % 7) + "\n";
+    }
+    const char* path = "threadpool_edges.txt";
+    std::ofstream(path) << text;
+    CSRGraph one = EdgeListLoader::loadCSR(path, 0, 1);
+    CSRGraph many = EdgeListLoader::loadCSR(path, 0, 5);
+    std::remove(path);
+    CHECK(one.getNumEntries() == 1000);
+    CHECK(std::equal(one.getTargets(), one.getTargets() + 1000, many.getTargets()));
+    ThreadPool::configureShared(0);
+}
+
+TEST_CASE("VersionedGraph - pending changes become visible on publish") {
+    Graph g(4);
+    g.addEdge(0, 1, 5);
+    VersionedGraph vg(g);
+    GraphSnapshot first = vg.snapshot();
+    CHECK(first.getVersion() == 1);
+    CHECK(first.getNumVertices() == 4);
+
+    vg.addEdge(1, 2, 3);
+    vg.addEdge(2, 3, 1);
+    vg.removeEdge(0, 1);
+    CHECK(vg.getNumPendingChanges() == 6);  // Both directions of each change
+    CHECK(vg.snapshot().getVersion() == 1);
+    CHECK(vg.snapshot().getGraph().getNumEntries() == 2);
+    CHECK_THROWS_AS(vg.addEdge(0, 9), std::out_of_range);
+    CHECK_THROWS_AS(vg.removeEdge(0, 3), std::runtime_error);
+
+    GraphSnapshot second = vg.publish();
+    CHECK(second.getVersion() == 2);
+    CHECK(vg.getNumPendingChanges() == 0);
+    CHECK(vg.snapshot().getVersion() == 2);
+    CHECK(vg.publish().getVersion() == 2);  // Nothing pending
+    CHECK(second.getGraph().getNumEntries() == 4);
+
+    // The old snapshot still sees its own version
+    CHECK(first.getGraph().getNumEntries() == 2);
+    CHECK(first.getGraph().getTargets()[0] == 1);
+    Graph tree = Algorithms::dijkstra(1, second.getGraph());
+    CHECK(tree.getAdjList()[2].neighbors->vertex == 3);
+}
+
+TEST_CASE("VersionedGraph - readers run queries while a writer publishes") {
+    // Version v is a path 0 - 1 - ... - v, so a query on it must reach exactly v + 1 vertices
+    const int n = 120;
+    Graph g(n);
+    g.addEdge(0, 1, 1);
+    VersionedGraph vg(g);
+
+    std::atomic<bool> writerDone(false);
+    std::atomic<int> mismatches(0);
+    std::atomic<long long> queries(0);
+    auto reader = [&]() {
+        std::vector<int> dist(n);
+        do {  // At least one query, even if the writer is already done
+            GraphSnapshot snap = vg.snapshot();
+            Algorithms::bfsDistances(0, snap.getGraph(), dist.data());
+            int reached = static_cast<int>(n - std::count(dist.begin(), dist.end(), INT_MAX));
+            Graph tree = Algorithms::dijkstra(0, snap.getGraph());
+            int treeEntries = 0;
+            for (int v = 0; v < n; v++) {
+                for (NeighborVer* e = tree.getAdjList()[v].neighbors; e; e = e->next) treeEntries++;
+            }
+            if (reached != static_cast<int>(snap.getVersion()) + 1 || treeEntries != 2 * (reached - 1)) {
+                mismatches++;
+            }
+            queries++;
+        } while (!writerDone.load());
+    };
+    std::thread readers[3] = {std::thread(reader), std::thread(reader), std::thread(reader)};
+    for (int v = 1; v < n - 1; v++) {
+        vg.addEdge(v, v + 1, 1);
+        vg.publish();
+    }
+    writerDone = true;
+    for (std::thread& t : readers) t.join();
+    CHECK(mismatches == 0);
+    CHECK(queries > 0);
+    CHECK(vg.snapshot().getVersion() == static_cast<unsigned long long>(n - 1));
+}
+
+// Reference all-pairs distances: Dijkstra-free relaxation until nothing changes
+static std::vector<int> referenceDistances(const Graph& g) {
+    int n = g.getNumVertices();
+    std::vector<int> d(static_cast<size_t>(n) * n, INT_MAX);
+    for (int s = 0; s < n; s++) {
+        int* row = &d[static_cast<size_t>(s) * n];
+        row[s] = 0;
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (int u = 0; u < n; u++) {
+                if (row[u] == INT_MAX) continue;
+                for (NeighborVer* e = g.getAdjList()[u].neighbors; e; e = e->next) {
+                    if (row[u] + e->weight < row[e->vertex]) {
+                        row[e->vertex] = row[u] + e->weight;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+    return d;
+}
+
+TEST_CASE("Algorithms - all-pairs shortest paths") {
+    // 150 vertices: the last Floyd-Warshall tile is partial; two components
+    Graph g = Generators::erdosRenyi(100, 400, 21);
+    Graph full(150);
+    for (int u = 0; u < 100; u++) {
+        for (NeighborVer* e = g.getAdjList()[u].neighbors; e; e = e->next) {
+            if (u < e->vertex) full.addEdge(u, e->vertex, e->weight);
+        }
+    }
+    for (int u = 100; u + 1 < 150; u++) {
+        full.addEdge(u, u + 1, u % 5);
+    }
+    std::vector<int> expected = referenceDistances(full);
+
+    DistanceMatrix fw = Algorithms::allPairsShortestPaths(full, Algorithms::FLOYD_WARSHALL);
+    DistanceMatrix dj = Algorithms::allPairsShortestPaths(full, Algorithms::REPEATED_DIJKSTRA);
+    DistanceMatrix automatic = Algorithms::allPairsShortestPaths(full);
+    CHECK(fw.getNumVertices() == 150);
+    bool same = true;
+    for (int u = 0; u < 150; u++) {
+        for (int v = 0; v < 150; v++) {
+            int e = expected[static_cast<size_t>(u) * 150 + v];
+            if (fw.get(u, v) != e || dj.get(u, v) != e || automatic.getRow(u)[v] != e) same = false;
+        }
+    }
+    CHECK(same);
+    CHECK(fw.get(0, 120) == INT_MAX);
+    CHECK(fw.get(149, 149) == 0);
+    CHECK_THROWS_AS(fw.get(150, 0), std::out_of_range);
+    CHECK_THROWS_AS(fw.getRow(-1), std::out_of_range);
+
+    std::vector<int> row(150);
+    Algorithms::dijkstraDistances(7, CSRGraph(full), row.data());
+    CHECK(std::equal(row.begin(), row.end(), dj.getRow(7)));
+    CHECK_THROWS_AS(Algorithms::dijkstraDistances(150, CSRGraph(full), row.data()), std::out_of_range);
+}
+
+TEST_CASE("Algorithms - all-pairs distances near INT_MAX") {
+    // One edge of 1.5e9: positive weights only, so no method may report a negative cycle
+    Graph single(2);
+    single.addEdge(0, 1, 1500000000);
+    Algorithms::AllPairsMethod methods[] = {Algorithms::AUTO, Algorithms::FLOYD_WARSHALL,
+                                            Algorithms::REPEATED_DIJKSTRA, Algorithms::JOHNSON};
+    for (Algorithms::AllPairsMethod method : methods) {
+        DistanceMatrix d = Algorithms::allPairsShortestPaths(single, method);
+        CHECK(d.get(0, 1) == 1500000000);
+        CHECK(d.get(1, 0) == 1500000000);
+        CHECK(d.get(0, 0) == 0);
+    }
+
+    // 0 - 1 - 2 with two 1.5e9 edges: 0 -> 2 does not fit in an int and reads as INT_MAX
+    Graph chain(3);
+    chain.addEdge(0, 1, 1500000000);
+    chain.addEdge(1, 2, 1500000000);
+    DistanceMatrix fw = Algorithms::allPairsShortestPaths(chain, Algorithms::FLOYD_WARSHALL);
+    DistanceMatrix dj = Algorithms::allPairsShortestPaths(chain, Algorithms::REPEATED_DIJKSTRA);
+    for (int u = 0; u < 3; u++) {
+        for (int v = 0; v < 3; v++) {
+            CHECK(fw.get(u, v) == dj.get(u, v));
+        }
+    }
+    CHECK(fw.get(0, 2) == INT_MAX);
+    CHECK(fw.get(1, 2) == 1500000000);
+}
+
+TEST_CASE("Algorithms - all-pairs method choice and negative weights") {
+    CSRGraph dense(Generators::erdosRenyi(200, 8000, 2));
+    CSRGraph sparse(Generators::path(3000, 2));
+    CHECK(Algorithms::chooseAllPairsMethod(dense) == Algorithms::FLOYD_WARSHALL);
+    CHECK(Algorithms::chooseAllPairsMethod(sparse) == Algorithms::REPEATED_DIJKSTRA);
+
+    // Directed with negative edges but no negative cycle: Floyd-Warshall is chosen
+    Graph d(4, true);
+    d.addEdge(0, 1, 4);
+    d.addEdge(0, 2, 1);
+    d.addEdge(2, 1, -2);
+    d.addEdge(1, 3, 3);
+    CHECK(Algorithms::chooseAllPairsMethod(CSRGraph(d)) == Algorithms::FLOYD_WARSHALL);
+    DistanceMatrix m = Algorithms::allPairsShortestPaths(d);
+    CHECK(m.get(0, 1) == -1);
+    CHECK(m.get(0, 3) == 2);
+    CHECK(m.get(3, 0) == INT_MAX);
+    CHECK_THROWS_AS(Algorithms::allPairsShortestPaths(d, Algorithms::REPEATED_DIJKSTRA), std::invalid_argument);
+
+    d.addEdge(1, 0, -5);  // Cycle 0 -> 2 -> 1 -> 0 of weight -6
+    CHECK_THROWS_AS(Algorithms::allPairsShortestPaths(d), std::invalid_argument);
+    Graph u(2);
+    u.addEdge(0, 1, -1);  // Undirected negative edge
+    CHECK_THROWS_AS(Algorithms::allPairsShortestPaths(u), std::invalid_argument);
+}
+
+TEST_CASE("Algorithms - Bellman-Ford variants with negative weights") {
+    // Directed graph: forward edges may be negative, backward edges are heavy, so no negative cycle
+    Graph g(120, true);
+    unsigned int state = 5;
+    for (int k = 0; k < 600; k++) {
+        state = state * 1664525u + 1013904223u;
+        int u = static_cast<int>((state >> 8) % 120);
+        int v = static_cast<int>((state >> 18) % 120);
+        if (u == v) continue;
+        int weight = (u < v) ? static_cast<int>(state % 41) - 20 : 200 + static_cast<int>(state % 50);
+        g.addEdge(u, v, weight);
+    }
+    CSRGraph csr(g);
+    std::vector<int> expected = referenceDistances(g);
+    CHECK_FALSE(Algorithms::hasNegativeCycle(g));
+
+    Algorithms::BellmanFordVariant variants[] = {Algorithms::ROUNDS, Algorithms::SPFA, Algorithms::PARALLEL_ROUNDS};
+    for (Algorithms::BellmanFordVariant variant : variants) {
+        for (int s = 0; s < 120; s += 17) {
+            std::vector<int> dist(120);
+            Algorithms::bellmanFordDistances(s, csr, dist.data(), variant);
+            CHECK(std::equal(dist.begin(), dist.end(), expected.begin() + s * 120));
+        }
+
+        // Tree edges carry the distance differences, so every root path has the shortest length
+        Graph tree = Algorithms::bellmanFord(0, g, variant);
+        CHECK(tree.isDirected());
+        std::vector<int> treeDist(120, INT_MAX);
+        std::vector<int> stack(1, 0);
+        treeDist[0] = 0;
+        while (!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+            for (NeighborVer* e = tree.getAdjList()[u].neighbors; e; e = e->next) {
+                treeDist[e->vertex] = treeDist[u] + e->weight;
+                stack.push_back(e->vertex);
+            }
+        }
+        CHECK(std::equal(treeDist.begin(), treeDist.end(), expected.begin()));
+    }
+
+    // Matches Dijkstra when all weights are non-negative
+    Graph positive = Generators::erdosRenyi(200, 900, 3);
+    std::vector<int> a(200), b(200);
+    Algorithms::bellmanFordDistances(11, CSRGraph(positive), a.data(), Algorithms::PARALLEL_ROUNDS);
+    Algorithms::dijkstraDistances(11, CSRGraph(positive), b.data());
+    CHECK(a == b);
+    CHECK_THROWS_AS(Algorithms::bellmanFord(120, g), std::out_of_range);
+}
+
+TEST_CASE("Algorithms - Bellman-Ford weights near INT_MAX") {
+    // Sums past INT_MAX must not wrap into a negative distance (or a false negative cycle)
+    Graph single(2);
+    single.addEdge(0, 1, 1500000000);
+    Graph chain(4, true);
+    chain.addEdge(0, 1, 1500000000);
+    chain.addEdge(1, 2, 1500000000);
+    chain.addEdge(0, 3, INT_MAX - 1);
+    chain.addEdge(3, 2, 5);
+    CHECK_FALSE(Algorithms::hasNegativeCycle(single));
+    CHECK_FALSE(Algorithms::hasNegativeCycle(chain));
+
+    Algorithms::BellmanFordVariant variants[] = {Algorithms::ROUNDS, Algorithms::SPFA, Algorithms::PARALLEL_ROUNDS};
+    for (Algorithms::BellmanFordVariant variant : variants) {
+        Graph tree = Algorithms::bellmanFord(0, single, variant);
+        CHECK(tree.getAdjList()[0].neighbors != nullptr);
+        CHECK(tree.getAdjList()[0].neighbors->weight == 1500000000);
+
+        std::vector<int> dist(4);
+        Algorithms::bellmanFordDistances(0, CSRGraph(chain), dist.data(), variant);
+        CHECK(dist[1] == 1500000000);
+        CHECK(dist[2] == INT_MAX);
+        CHECK(dist[3] == INT_MAX - 1);
+    }
+}
+
+TEST_CASE("Algorithms - negative cycle detection") {
+    Graph g(5, true);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, -1);
+    g.addEdge(3, 4, 1);
+    g.addEdge(4, 3, -3);  // Negative cycle 3 <-> 4, not reachable from 0
+    CHECK(Algorithms::hasNegativeCycle(g));
+    Algorithms::BellmanFordVariant variants[] = {Algorithms::ROUNDS, Algorithms::SPFA, Algorithms::PARALLEL_ROUNDS};
+    for (Algorithms::BellmanFordVariant variant : variants) {
+        Graph tree = Algorithms::bellmanFord(0, g, variant);
+        CHECK(tree.getAdjList()[1].neighbors->weight == -1);
+        CHECK_THROWS_AS(Algorithms::bellmanFord(3, g, variant), std::invalid_argument);
+    }
+
+    g.addEdge(2, 0, -1);  // Cycle 0 -> 1 -> 2 -> 0 of weight 0 is fine
+    CHECK_NOTHROW(Algorithms::bellmanFord(0, g));
+    g.removeEdge(2, 0);
+    g.addEdge(2, 0, -2);  // Now -1
+    for (Algorithms::BellmanFordVariant variant : variants) {
+        CHECK_THROWS_AS(Algorithms::bellmanFord(0, g, variant), std::invalid_argument);
+    }
+
+    Graph undirected(3);
+    undirected.addEdge(0, 1, 4);
+    CHECK_FALSE(Algorithms::hasNegativeCycle(undirected));
+    undirected.addEdge(1, 2, -1);  // Can be walked back and forth
+    CHECK(Algorithms::hasNegativeCycle(undirected));
+}
+
+TEST_CASE("Algorithms - Johnson all-pairs shortest paths") {
+    // Sparse directed graph: a long chain with negative shortcuts, heavy edges back
+    const int n = 400;
+    Graph g(n, true);
+    for (int v = 0; v + 1 < n; v++) {
+        g.addEdge(v, v + 1, 3);
+    }
+    unsigned int state = 17;
+    for (int k = 0; k < 300; k++) {
+        state = state * 1664525u + 1013904223u;
+        int u = static_cast<int>((state >> 8) % n);
+        int v = static_cast<int>((state >> 20) % n);
+        if (u == v || g.getAdjList()[u].neighbors->vertex == v) continue;
+        if (u < v) {
+            g.addEdge(u, v, -static_cast<int>(state % 7));
+        } else {
+            g.addEdge(u, v, 5000);
+        }
+    }
+    CSRGraph csr(g);
+    CHECK(Algorithms::chooseAllPairsMethod(csr) == Algorithms::FLOYD_WARSHALL);  // Still small enough
+
+    Graph chain(3000, true);
+    for (int v = 0; v + 1 < 3000; v++) {
+        chain.addEdge(v, v + 1, v % 10 == 0 ? -1 : 2);
+    }
+    CHECK(Algorithms::chooseAllPairsMethod(CSRGraph(chain)) == Algorithms::JOHNSON);
+
+    DistanceMatrix johnson = Algorithms::allPairsShortestPaths(g, Algorithms::JOHNSON);
+    DistanceMatrix fw = Algorithms::allPairsShortestPaths(csr, Algorithms::FLOYD_WARSHALL);
+    bool same = true;
+    for (int u = 0; u < n; u++) {
+        if (!std::equal(johnson.getRow(u), johnson.getRow(u) + n, fw.getRow(u))) same = false;
+    }
+    CHECK(same);
+    std::vector<int> row(n);
+    Algorithms::bellmanFordDistances(42, csr, row.data());
+    CHECK(std::equal(row.begin(), row.end(), johnson.getRow(42)));
+
+    // Non-negative weights: same as plain repeated Dijkstra
+    Graph positive = Generators::erdosRenyi(150, 500, 4);
+    DistanceMatrix a = Algorithms::allPairsShortestPaths(positive, Algorithms::JOHNSON);
+    DistanceMatrix b = Algorithms::allPairsShortestPaths(positive, Algorithms::REPEATED_DIJKSTRA);
+    CHECK(std::equal(a.getRow(0), a.getRow(0) + 150 * 150, b.getRow(0)));
+
+    // A negative cycle anywhere makes the potentials impossible
+    Graph cyclic(3, true);
+    cyclic.addEdge(0, 1, 1);
+    cyclic.addEdge(1, 2, -2);
+    cyclic.addEdge(2, 1, 1);
+    CHECK_THROWS_AS(Algorithms::allPairsShortestPaths(cyclic, Algorithms::JOHNSON), std::invalid_argument);
+}